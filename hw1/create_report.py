@@ -96,8 +96,8 @@ def generate_pdf_report(df):
     intro_text = (
         "This report compares several optimization techniques for matrix-vector multiplication against a baseline compiled with g++ -O3. "
         "It is important to note that all optimized versions (interchange, unroll, and AVX2) are contained within the 'hw1' executable, "
-        "which is compiled with AVX2 and FMA support (`-march=native -mavx2 -mfma`). This enables the AVX2-specific code to function and may "
-        "allow the compiler to perform additional optimizations on the other versions.\n\n"
+        "which is built for the generic x86-64 baseline. The AVX2/FMA kernel is compiled for that instruction set individually and is only "
+        "run after the CPU has been checked for support at runtime; the other versions receive no extra compiler flags.\n\n"
         "The optimized techniques tested are:\n"
         "1.  AVX2 SIMD: Leverages data parallelism by explicitly using AVX2 intrinsics to process 8 single-precision floats simultaneously.\n"
         "2.  Loop Unrolling: Reduces loop overhead by manually processing 4 elements per inner-loop iteration.\n"
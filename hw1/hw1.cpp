@@ -4,7 +4,35 @@
 #include <cstdlib>
 #include <string>
 #include <cstring>
-#include <immintrin.h> // Required for AVX2
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <complex>
+#include <random>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <immintrin.h> // SIMD intrinsics; enabled per function via target attributes
+
+// The binary is built for the generic x86-64 baseline. Kernels that need newer
+// instruction sets are compiled for them individually and only called after
+// the CPU has been checked at runtime (see select_isa).
+#define TARGET_SSE42  __attribute__((target("sse4.2")))
+#define TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#define TARGET_F16C   __attribute__((target("avx2,fma,f16c")))
+#define TARGET_AVX512_BF16 __attribute__((target("avx512bf16,avx512f,avx2,fma")))
+#define TARGET_AVX512_VNNI __attribute__((target("avx512vnni,avx512bw,avx512f,avx2,fma")))
 
 using namespace std;
 
@@ -20,107 +48,2118 @@ double get_microtime_resolution() {
 }
 
 void print_usage(const char* prog_name) {
-    cerr << "Usage: " << prog_name << " [optimization_type] <matrix_size_n>" << endl;
-    cerr << "  <optimization_type> is optional and defaults to 'avx2'." << endl;
+    cerr << "Usage: " << prog_name << " [options] [optimization_type] <matrix_size_n>" << endl;
+    cerr << "  <optimization_type> is optional and defaults to 'auto'." << endl;
+    cerr << "Options:" << endl;
+    cerr << "  --threads=N - Worker threads for parallel kernels and matrix initialization" << endl;
+    cerr << "                (default: all hardware threads)" << endl;
+    cerr << "  --tile=N    - k-panel width in floats for 'blocked' (default: 4096, i.e. 16 KB of B)" << endl;
+    cerr << "  --batch=K   - Right-hand-side vectors per call for 'batched' (default: 8)" << endl;
+    cerr << "  --nnz=K     - Average nonzeros per row of the sparse test matrix (default: 32)" << endl;
+    cerr << "  --sigma=S   - SELL-C-sigma sorting window in rows (default: 256)" << endl;
+    cerr << "  --block=B   - Dense block size (4 or 8) of the block-sparse matrix for bsr/bcsr (default: 4)" << endl;
+    cerr << "  --bandwidth=W - Sub- and super-diagonals of the banded matrix for 'band' (default: 8)" << endl;
+    cerr << "  --pages=P   - Page backing for A: default, thp (madvise) or hugetlb (MAP_HUGETLB)" << endl;
+    cerr << "  --numa      - parallel only: pin threads to CPUs so each first-touches its rows of A locally" << endl;
+    cerr << "  --isa=ISA   - Force the kernel used by auto/parallel/csr/sell/bsr/bf16/int8: scalar, sse4.2, avx2, avx512" << endl;
     cerr << "Optimization types:" << endl;
+    cerr << "  auto        - Fastest SIMD kernel supported by this CPU (runtime dispatch)" << endl;
     cerr << "  baseline    - Standard i-k loop implementation" << endl;
     cerr << "  avx2        - AVX2 SIMD optimization" << endl;
+    cerr << "  avx2x2/x4/x8 - AVX2 with 2, 4 or 8 independent FMA accumulators" << endl;
+    cerr << "  avx2r4/r8   - AVX2 register-blocked over 4 or 8 rows, one B load per chunk" << endl;
+    cerr << "  blocked     - AVX2 tiled over k so each B panel stays in L1 (see --tile)" << endl;
+    cerr << "  batched     - A times --batch vectors per call, reading A once (skinny GEMM)" << endl;
+    cerr << "  hilbert     - Matrix-free: A[i][j] = 1/(i+j+2) generated in registers, A never stored" << endl;
+    cerr << "  hankel      - O(n log n) FFT product using A's Hankel structure, checked against avx2" << endl;
+    cerr << "  avx512      - AVX-512 SIMD (falls back to auto without AVX-512)" << endl;
     cerr << "  unroll      - Loop unrolling optimization" << endl;
     cerr << "  interchange - Loop interchange (demonstrates cache effects)" << endl;
+    cerr << "  parallel    - Multi-threaded AVX2, rows split across a thread pool" << endl;
+    cerr << "  transpose   - A^T * B streaming A row by row (AXPY updates), no transposed copy" << endl;
+    cerr << "  transpose_parallel - Multi-threaded transpose with per-thread partial outputs" << endl;
+    cerr << "  fused       - A * B and A^T * B together in a single pass over A" << endl;
+    cerr << "  csr         - Sparse A in CSR format, AVX2 gather SpMV (scalar below AVX2), multi-threaded" << endl;
+    cerr << "  sell        - Same sparse A in SELL-C-sigma format (C = 8 AVX2, 16 AVX-512), one row per lane" << endl;
+    cerr << "  bsr         - Block-sparse A (dense --block blocks) in BSR format, AVX2 block kernel" << endl;
+    cerr << "  bcsr        - The same block-sparse A in plain CSR, for comparison with bsr" << endl;
+    cerr << "  band        - Banded A (--bandwidth) in diagonal-major storage, O(n * bandwidth)" << endl;
+    cerr << "  fp16        - A stored as IEEE half (F16C convert on load), fp32 accumulation" << endl;
+    cerr << "  bf16        - A and B stored as bfloat16 (AVX512-BF16 dot products, else AVX2)" << endl;
+    cerr << "  int8        - A quantized to int8 with per-row scales (VNNI, else AVX2 maddubs)" << endl;
+    cerr << "  kahan       - AVX2 with per-lane Kahan compensation, reports cost vs plain FMA" << endl;
+    cerr << "  pairwise    - AVX2 with pairwise (tree) summation of 128-column blocks" << endl;
+    cerr << "  fp32        - Precision family, fp32 storage and accumulation (same kernel as avx2)" << endl;
+    cerr << "  mixed       - Precision family, fp32 storage with fp64 accumulation" << endl;
+    cerr << "  fp64        - Precision family, fp64 storage and accumulation" << endl;
+    cerr << "  symv        - Symmetric A in packed upper-triangular storage (half the memory)" << endl;
 }
 
-// --- Optimization Implementations (all use float for consistency with Mv.cpp) ---
+// Parses "--name=value" into name/value. Returns false if arg is not an option.
+bool parse_option(const char* arg, string& name, string& value) {
+    if (strncmp(arg, "--", 2) != 0) return false;
+    string opt(arg + 2);
+    size_t eq = opt.find('=');
+    name = opt.substr(0, eq);
+    value = (eq == string::npos) ? "" : opt.substr(eq + 1);
+    return true;
+}
+
+// --- Thread Pool ---
+// Workers are created once and reused for every parallel kernel call, so thread
+// start-up cost stays outside the timed region. The calling thread acts as
+// worker 0, so a pool of size 1 runs everything inline.
+// With pin_threads, worker tid is bound to one CPU, spread evenly over the CPUs
+// the process may use so that every socket gets its share of the workers.
+class ThreadPool {
+public:
+    explicit ThreadPool(int num_threads, bool pin_threads = false)
+        : num_threads(max(1, num_threads)), pinned(pin_threads),
+          cpu_of(this->num_threads, -1), node_of(this->num_threads, 0) {
+        if (pinned) {
+            cpu_set_t allowed;
+            sched_getaffinity(0, sizeof(allowed), &allowed);
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed)) allowed_cpus.push_back(cpu);
+            }
+            pin_current_thread(0);
+        }
+        for (int tid = 1; tid < this->num_threads; ++tid) {
+            workers.emplace_back(&ThreadPool::worker_loop, this, tid);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        start_cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    int size() const { return num_threads; }
+    bool is_pinned() const { return pinned; }
+    // CPU and NUMA node worker tid runs on (valid after the first run() when pinned)
+    int cpu(int tid) const { return cpu_of[tid]; }
+    int node(int tid) const { return node_of[tid]; }
+
+    // Runs task(tid) for every tid in [0, size()) and waits for all of them.
+    void run(const function<void(int)>& task) {
+        {
+            lock_guard<mutex> lock(mtx);
+            current_task = &task;
+            pending = num_threads - 1;
+            ++generation;
+        }
+        start_cv.notify_all();
+        task(0);
+        unique_lock<mutex> lock(mtx);
+        done_cv.wait(lock, [this] { return pending == 0; });
+        current_task = nullptr;
+    }
+
+private:
+    void pin_current_thread(int tid) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(allowed_cpus[(size_t)tid * allowed_cpus.size() / num_threads], &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        unsigned cpu = 0, node = 0;
+        syscall(SYS_getcpu, &cpu, &node, nullptr);
+        cpu_of[tid] = cpu;
+        node_of[tid] = node;
+    }
+
+    void worker_loop(int tid) {
+        if (pinned) pin_current_thread(tid);
+        unsigned long seen = 0;
+        for (;;) {
+            const function<void(int)>* task;
+            {
+                unique_lock<mutex> lock(mtx);
+                start_cv.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                task = current_task;
+            }
+            (*task)(tid);
+            lock_guard<mutex> lock(mtx);
+            if (--pending == 0) done_cv.notify_one();
+        }
+    }
+
+    int num_threads;
+    bool pinned;
+    vector<int> allowed_cpus, cpu_of, node_of;
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable start_cv, done_cv;
+    const function<void(int)>* current_task = nullptr;
+    unsigned long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+// Splits [0, n) into nparts contiguous blocks and returns block 'part'.
+void block_range(int n, int part, int nparts, int& begin, int& end) {
+    int base = n / nparts, extra = n % nparts;
+    begin = part * base + min(part, extra);
+    end = begin + base + (part < extra ? 1 : 0);
+}
+
+// --- Aligned Matrix Storage ---
+// Row-major matrix whose rows are padded to a leading dimension (ld) that is a
+// multiple of 16 elements (and of 64 bytes for narrower element types), in
+// 64-byte aligned memory. Every row starts on a cache line, and the padding
+// columns are zero, so SIMD kernels use aligned loads and run to the next
+// vector multiple instead of finishing with a scalar tail.
+// Vectors are 1 x n matrices, so B has the same padding as A's rows.
+const int SIMD_PAD = 16; // floats per 64-byte cache line (one AVX-512 register)
+
+inline int round_up(int x, int multiple) {
+    return (x + multiple - 1) / multiple * multiple;
+}
+
+// Same for byte counts, which exceed int range for matrices of 2 GB and more
+inline size_t round_up_size(size_t x, size_t multiple) {
+    return (x + multiple - 1) / multiple * multiple;
+}
+
+// Page size backing a matrix. Large matrices are swept row by row, so with 4 KB
+// pages every 4 KB of A costs a TLB miss; 2 MB pages cut that 512-fold.
+//   Default         - regular 4 KB pages
+//   TransparentHuge - 2 MB aligned and madvise(MADV_HUGEPAGE); the kernel may
+//                     still hand out 4 KB pages, see huge_page_bytes()
+//   HugeTLB         - explicit mmap(MAP_HUGETLB) from the reserved hugetlb pool
+enum class PageBacking { Default, TransparentHuge, HugeTLB };
+
+const size_t HUGE_PAGE_SIZE = 2 << 20;
+
+const char* page_backing_name(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::TransparentHuge: return "thp";
+        case PageBacking::HugeTLB: return "hugetlb";
+        default: return "default";
+    }
+}
+
+// Bytes of transparent huge pages backing the mapping that contains addr,
+// read from the AnonHugePages field of /proc/self/smaps (0 if unavailable).
+size_t anon_huge_bytes(const void* addr) {
+    ifstream smaps("/proc/self/smaps");
+    string line;
+    bool in_mapping = false;
+    uintptr_t target = reinterpret_cast<uintptr_t>(addr);
+    while (getline(smaps, line)) {
+        unsigned long start, end;
+        char dash;
+        istringstream header(line);
+        if (header >> hex >> start >> dash >> end && dash == '-') {
+            in_mapping = (target >= start && target < end);
+        } else if (in_mapping && line.compare(0, 14, "AnonHugePages:") == 0) {
+            return stoul(line.substr(14)) * 1024;
+        }
+    }
+    return 0;
+}
+
+template <typename T>
+class AlignedMatrixOf {
+public:
+    // Falls back hugetlb -> thp -> default when the requested backing is unavailable.
+    // With zero_fill = false the memory is left untouched so that the threads
+    // using it can first-touch it; the caller must then zero the padding itself.
+    AlignedMatrixOf(int rows, int cols, PageBacking requested = PageBacking::Default,
+                  bool zero_fill = true)
+        : num_rows(rows), num_cols(cols), stride(round_up(cols, max<int>(SIMD_PAD, 64 / sizeof(T)))) {
+        size_t bytes = max<size_t>(1, (size_t)num_rows * stride) * sizeof(T);
+        size_t huge_bytes = round_up_size(bytes, HUGE_PAGE_SIZE);
+        if (requested == PageBacking::HugeTLB) {
+            void* p = mmap(nullptr, huge_bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                buffer = static_cast<T*>(p); // mmap memory is already zeroed
+                alloc_bytes = huge_bytes;
+                obtained = PageBacking::HugeTLB;
+                return;
+            }
+        }
+        if (requested != PageBacking::Default) {
+            buffer = static_cast<T*>(aligned_alloc(HUGE_PAGE_SIZE, huge_bytes));
+            if (buffer != nullptr && madvise(buffer, huge_bytes, MADV_HUGEPAGE) == 0) {
+                obtained = PageBacking::TransparentHuge;
+            }
+        } else {
+            buffer = static_cast<T*>(aligned_alloc(64, round_up_size(bytes, 64)));
+        }
+        if (buffer == nullptr) throw bad_alloc();
+        alloc_bytes = bytes;
+        if (zero_fill) memset(buffer, 0, bytes);
+    }
+    ~AlignedMatrixOf() {
+        if (obtained == PageBacking::HugeTLB) {
+            munmap(buffer, alloc_bytes);
+        } else {
+            free(buffer);
+        }
+    }
+    AlignedMatrixOf(const AlignedMatrixOf&) = delete;
+    AlignedMatrixOf& operator=(const AlignedMatrixOf&) = delete;
+
+    int rows() const { return num_rows; }
+    int cols() const { return num_cols; }
+    size_t ld() const { return stride; }
+    T* data() { return buffer; }
+    const T* data() const { return buffer; }
+    T* row(int i) { return buffer + (size_t)i * stride; }
+    const T* row(int i) const { return buffer + (size_t)i * stride; }
+    PageBacking backing() const { return obtained; }
+    size_t bytes() const { return alloc_bytes; }
+
+    // Bytes actually resident in 2 MB pages (only meaningful once touched)
+    size_t huge_page_bytes() const {
+        if (obtained == PageBacking::HugeTLB) return alloc_bytes;
+        if (obtained == PageBacking::TransparentHuge) return min(alloc_bytes, anon_huge_bytes(buffer));
+        return 0;
+    }
+
+private:
+    int num_rows, num_cols;
+    size_t stride;
+    T* buffer = nullptr;
+    size_t alloc_bytes = 0;
+    PageBacking obtained = PageBacking::Default;
+};
+
+using AlignedMatrix = AlignedMatrixOf<float>;
+
+// --- Packed Symmetric Storage ---
+// Upper triangle of a symmetric n x n matrix, packed row by row: row i holds
+// A[i][i .. n-1] (n - i floats), so the whole matrix takes n(n+1)/2 floats,
+// about half of the dense layout. Row starts are not SIMD aligned.
+class PackedSymmetricMatrix {
+public:
+    explicit PackedSymmetricMatrix(int n) : dim(n), length((size_t)n * (n + 1) / 2) {
+        size_t bytes = max<size_t>(1, length) * sizeof(float);
+        buffer = static_cast<float*>(aligned_alloc(64, (bytes + 63) / 64 * 64));
+        if (buffer == nullptr) throw bad_alloc();
+    }
+    ~PackedSymmetricMatrix() { free(buffer); }
+    PackedSymmetricMatrix(const PackedSymmetricMatrix&) = delete;
+    PackedSymmetricMatrix& operator=(const PackedSymmetricMatrix&) = delete;
+
+    int size() const { return dim; }
+    size_t bytes() const { return length * sizeof(float); }
+    float* data() { return buffer; }
+    const float* data() const { return buffer; }
+    // Row i starts at A[i][i]
+    float* row(int i) { return buffer + packed_offset(i); }
+    const float* row(int i) const { return buffer + packed_offset(i); }
+
+    // Rows 0 .. i-1 hold n + (n-1) + ... + (n-i+1) floats
+    size_t packed_offset(int i) const { return (size_t)i * dim - (size_t)i * (i - 1) / 2; }
 
+private:
+    int dim;
+    size_t length;
+    float* buffer;
+};
 
+// --- Banded Storage ---
+// Band matrix with kl sub- and ku super-diagonals stored diagonal-major
+// (DIA-like): row kl + d of 'diags' holds diagonal d (-kl <= d <= ku), indexed
+// by the row of A, i.e. diag(d)[i] = A[i][i+d]. LAPACK's GB layout indexes
+// diagonals by column instead (AB(ku+1+i-j, j) = A(i,j)), so this buffer is not
+// a ?gbmv operand. Entries falling outside A are zero. Takes (kl + ku + 1) * n
+// floats instead of n * n.
+class BandMatrix {
+public:
+    BandMatrix(int n, int kl, int ku) : dim(n), lower(kl), upper(ku), diags(n > 0 ? kl + ku + 1 : 0, n) {}
+
+    int size() const { return dim; }
+    int kl() const { return lower; }
+    int ku() const { return upper; }
+    float* diag(int d) { return diags.row(lower + d); }
+    const float* diag(int d) const { return diags.row(lower + d); }
+    size_t bytes() const { return (size_t)diags.rows() * diags.ld() * sizeof(float); }
+
+private:
+    int dim, lower, upper;
+    AlignedMatrix diags;
+};
+
+// --- Sparse Storage (CSR) ---
+// Compressed sparse row: the nonzeros of row i are values[row_ptr[i] ..
+// row_ptr[i+1]) in columns col_idx[same range], sorted by column.
+struct CsrMatrix {
+    int rows = 0, cols = 0;
+    vector<int> row_ptr{0};
+    vector<int> col_idx;
+    vector<float> values;
+
+    size_t nnz() const { return values.size(); }
+};
+
+// --- Sparse Storage (SELL-C-sigma) ---
+// Sliced ELLPACK: rows are sorted by length (longest first) within windows of
+// sigma rows, then grouped into chunks of C rows. Each chunk is padded to its
+// longest row and stored column-major, so entry k of all C rows is contiguous
+// and one SIMD lane handles one row. Sorting keeps rows of similar length in
+// a chunk, which keeps the zero padding small.
+struct SellMatrix {
+    int rows = 0, chunk_size = 0, sigma = 0;
+    vector<int> chunk_ptr{0};  // chunk c occupies [chunk_ptr[c], chunk_ptr[c+1])
+    vector<int> chunk_len;     // padded row length of chunk c
+    vector<int> row_perm;      // original row in chunk slot, -1 for padding slots
+    vector<int> col_idx;       // padding entries point at column 0 ...
+    vector<float> values;      // ... with value 0
+    size_t nnz = 0;            // nonzeros before padding
+
+    int num_chunks() const { return (int)chunk_len.size(); }
+};
+
+SellMatrix csr_to_sell(const CsrMatrix& S, int chunk_size, int sigma) {
+    SellMatrix M;
+    M.rows = S.rows;
+    M.chunk_size = chunk_size;
+    M.sigma = sigma = max(sigma, 1);
+    M.nnz = S.nnz();
+    const int num_chunks = (S.rows + chunk_size - 1) / chunk_size;
+    M.row_perm.assign((size_t)num_chunks * chunk_size, -1);
+    for (int i = 0; i < S.rows; ++i) M.row_perm[i] = i;
+    auto row_len = [&](int i) { return S.row_ptr[i + 1] - S.row_ptr[i]; };
+    for (int w = 0; w < S.rows; w += sigma) {
+        stable_sort(M.row_perm.begin() + w, M.row_perm.begin() + min(S.rows, w + sigma),
+                    [&](int a, int b) { return row_len(a) > row_len(b); });
+    }
+    for (int c = 0; c < num_chunks; ++c) {
+        int len = 0;
+        for (int lane = 0; lane < chunk_size; ++lane) {
+            int i = M.row_perm[c * chunk_size + lane];
+            if (i >= 0) len = max(len, row_len(i));
+        }
+        M.chunk_len.push_back(len);
+        M.chunk_ptr.push_back(M.chunk_ptr.back() + len * chunk_size);
+    }
+    M.col_idx.assign(M.chunk_ptr.back(), 0);
+    M.values.assign(M.chunk_ptr.back(), 0.0f);
+    for (int c = 0; c < num_chunks; ++c) {
+        for (int lane = 0; lane < chunk_size; ++lane) {
+            int i = M.row_perm[c * chunk_size + lane];
+            if (i < 0) continue;
+            for (int k = 0; k < row_len(i); ++k) {
+                size_t slot = M.chunk_ptr[c] + (size_t)k * chunk_size + lane;
+                M.col_idx[slot] = S.col_idx[S.row_ptr[i] + k];
+                M.values[slot] = S.values[S.row_ptr[i] + k];
+            }
+        }
+    }
+    return M;
+}
+
+// --- Sparse Storage (BSR) ---
+// Block sparse row: the matrix is tiled into block x block dense blocks and
+// only nonzero blocks are stored, row-major within the block. One column
+// index per block instead of per entry cuts index storage and traffic by
+// block^2 versus CSR. Block rows at the bottom edge are zero-padded.
+struct BsrMatrix {
+    int rows = 0, cols = 0, block = 0, block_rows = 0;
+    vector<int> block_row_ptr{0}; // blocks of block row I: [block_row_ptr[I], block_row_ptr[I+1])
+    vector<int> block_col;        // block column index (first column / block)
+    vector<float> values;         // block * block floats per block
+
+    size_t num_blocks() const { return block_col.size(); }
+};
+
+BsrMatrix csr_to_bsr(const CsrMatrix& S, int block) {
+    BsrMatrix M;
+    M.rows = S.rows;
+    M.cols = S.cols;
+    M.block = block;
+    M.block_rows = (S.rows + block - 1) / block;
+    vector<int> cols;
+    for (int I = 0; I < M.block_rows; ++I) {
+        const int row_end = min(S.rows, (I + 1) * block);
+        cols.clear();
+        for (int i = I * block; i < row_end; ++i) {
+            for (int p = S.row_ptr[i]; p < S.row_ptr[i + 1]; ++p) cols.push_back(S.col_idx[p] / block);
+        }
+        sort(cols.begin(), cols.end());
+        cols.erase(unique(cols.begin(), cols.end()), cols.end());
+        const size_t first = M.block_col.size();
+        M.block_col.insert(M.block_col.end(), cols.begin(), cols.end());
+        M.block_row_ptr.push_back((int)M.block_col.size());
+        M.values.resize(M.block_col.size() * block * block, 0.0f);
+        for (int i = I * block; i < row_end; ++i) {
+            for (int p = S.row_ptr[i]; p < S.row_ptr[i + 1]; ++p) {
+                const int J = S.col_idx[p] / block;
+                const size_t b = first + (lower_bound(cols.begin(), cols.end(), J) - cols.begin());
+                M.values[b * block * block + (i - I * block) * block + S.col_idx[p] % block] = S.values[p];
+            }
+        }
+    }
+    return M;
+}
+
+// --- Optimization Implementations (all use float for consistency with Mv.cpp) ---
+// Every kernel computes C[0..rows) = A * B for a rows x cols block of A with
+// leading dimension ld. A and B must come from AlignedMatrix (aligned rows,
+// zeroed padding); a sub-block of rows is passed by offsetting A and C.
+typedef void (*MvKernel)(const float* A, int rows, int cols, size_t ld, const float* B, float* C);
 
 // 1. Loop Interchange (k-i loop order)
-void Mv_mult_interchanged(int n, const vector<float>& A, const vector<float>& B, vector<float>& C) {
-    fill(C.begin(), C.end(), 0.0f);
-    for (int k = 0; k < n; ++k) {
-        for (int i = 0; i < n; ++i) {
-            C[i] += A[i * n + k] * B[k];
+void Mv_mult_interchanged(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    fill(C, C + rows, 0.0f);
+    for (int k = 0; k < cols; ++k) {
+        for (int i = 0; i < rows; ++i) {
+            C[i] += A[i * ld + k] * B[k];
         }
     }
 }
 
-// 2. Loop Unrolling (unroll factor of 4)
-void Mv_mult_unrolled(int n, const vector<float>& A, const vector<float>& B, vector<float>& C) {
-    for (int i = 0; i < n; ++i) {
+// 2. Loop Unrolling (unroll factor of 4; zero padding covers the remainder)
+void Mv_mult_unrolled(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 4);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
         float sum = 0.0f;
-        int k = 0;
-        for (; k <= n - 4; k += 4) {
-            sum += A[i * n + k] * B[k];
-            sum += A[i * n + k + 1] * B[k + 1];
-            sum += A[i * n + k + 2] * B[k + 2];
-            sum += A[i * n + k + 3] * B[k + 3];
-        }
-        // Handle remainder
-        for (; k < n; ++k) {
-            sum += A[i * n + k] * B[k];
+        for (int k = 0; k < padded; k += 4) {
+            sum += a_row[k] * B[k];
+            sum += a_row[k + 1] * B[k + 1];
+            sum += a_row[k + 2] * B[k + 2];
+            sum += a_row[k + 3] * B[k + 3];
         }
         C[i] = sum;
     }
 }
 
+// Horizontal sum of the 8 lanes
+TARGET_AVX2
+inline float hsum256(__m256 v) {
+    float c_sum_array[8];
+    _mm256_storeu_ps(c_sum_array, v);
+    return c_sum_array[0] + c_sum_array[1] + c_sum_array[2] + c_sum_array[3] +
+           c_sum_array[4] + c_sum_array[5] + c_sum_array[6] + c_sum_array[7];
+}
+
 // 3. AVX2 SIMD Optimization
-void Mv_mult_avx2(int n, const vector<float>& A, const vector<float>& B, vector<float>& C) {
-    for (int i = 0; i < n; ++i) {
+TARGET_AVX2
+void Mv_mult_avx2(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 8);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
         __m256 c_vec = _mm256_setzero_ps();
-        int k = 0;
-        for (; k <= n - 8; k += 8) {
-            __m256 a_vec = _mm256_loadu_ps(&A[i * n + k]);
-            __m256 b_vec = _mm256_loadu_ps(&B[k]);
+        for (int k = 0; k < padded; k += 8) {
+            __m256 a_vec = _mm256_load_ps(a_row + k);
+            __m256 b_vec = _mm256_load_ps(B + k);
             c_vec = _mm256_fmadd_ps(a_vec, b_vec, c_vec);
         }
-        float c_sum_array[8];
-        _mm256_storeu_ps(c_sum_array, c_vec);
-        float sum = c_sum_array[0] + c_sum_array[1] + c_sum_array[2] + c_sum_array[3] +
-                    c_sum_array[4] + c_sum_array[5] + c_sum_array[6] + c_sum_array[7];
-        for (; k < n; ++k) {
-            sum += A[i * n + k] * B[k];
+        C[i] = hsum256(c_vec);
+    }
+}
+
+// 3b. AVX2 with NACC independent accumulators. A single accumulator makes every
+// FMA wait on the previous one (4-5 cycle latency); interleaving NACC chains
+// keeps both FMA ports busy. The chains are combined once per row.
+template <int NACC>
+TARGET_AVX2
+void Mv_mult_avx2_multiacc(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 8);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        __m256 acc[NACC];
+        for (int a = 0; a < NACC; ++a) acc[a] = _mm256_setzero_ps();
+        int k = 0;
+        for (; k <= padded - 8 * NACC; k += 8 * NACC) {
+            for (int a = 0; a < NACC; ++a) {
+                __m256 a_vec = _mm256_load_ps(a_row + k + 8 * a);
+                __m256 b_vec = _mm256_load_ps(B + k + 8 * a);
+                acc[a] = _mm256_fmadd_ps(a_vec, b_vec, acc[a]);
+            }
+        }
+        for (; k < padded; k += 8) {
+            acc[0] = _mm256_fmadd_ps(_mm256_load_ps(a_row + k), _mm256_load_ps(B + k), acc[0]);
+        }
+        // Pairwise combine: NACC/2 adds, then NACC/4, ...
+        for (int width = NACC / 2; width > 0; width /= 2) {
+            for (int a = 0; a < width; ++a) acc[a] = _mm256_add_ps(acc[a], acc[a + width]);
+        }
+        C[i] = hsum256(acc[0]);
+    }
+}
+
+// Transposing horizontal add: returns {sum(r0), sum(r1), sum(r2), sum(r3)}
+TARGET_AVX2
+inline __m128 hsum4_avx2(__m256 r0, __m256 r1, __m256 r2, __m256 r3) {
+    __m256 s01 = _mm256_hadd_ps(r0, r1);   // r0 r0 r1 r1 | r0 r0 r1 r1
+    __m256 s23 = _mm256_hadd_ps(r2, r3);   // r2 r2 r3 r3 | r2 r2 r3 r3
+    __m256 s = _mm256_hadd_ps(s01, s23);   // r0 r1 r2 r3 | r0 r1 r2 r3
+    return _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+}
+
+// 3c. AVX2 register-blocked over ROWS rows (4 or 8). Each B chunk is loaded once
+// and reused by ROWS row accumulators, roughly halving loads issued per FMA.
+template <int ROWS>
+TARGET_AVX2
+void Mv_mult_avx2_rowblock(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 8);
+    int i = 0;
+    for (; i <= rows - ROWS; i += ROWS) {
+        const float* a_rows = A + i * ld;
+        __m256 acc[ROWS];
+        for (int r = 0; r < ROWS; ++r) acc[r] = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 8) {
+            __m256 b_vec = _mm256_load_ps(B + k);
+            for (int r = 0; r < ROWS; ++r) {
+                acc[r] = _mm256_fmadd_ps(_mm256_load_ps(a_rows + r * ld + k), b_vec, acc[r]);
+            }
+        }
+        for (int r = 0; r < ROWS; r += 4) {
+            _mm_storeu_ps(C + i + r, hsum4_avx2(acc[r], acc[r + 1], acc[r + 2], acc[r + 3]));
+        }
+    }
+    // Leftover rows
+    Mv_mult_avx2(A + i * ld, rows - i, cols, ld, B, C + i);
+}
+
+// 3d. Cache-blocked AVX2: the k dimension is cut into panels of 'tile' floats.
+// One B panel stays L1-resident while every row streams through it, with
+// partial sums accumulated in C.
+TARGET_AVX2
+void Mv_mult_blocked(const float* A, int rows, int cols, size_t ld, const float* B, float* C,
+                     int tile) {
+    const int padded = round_up(cols, 8);
+    tile = round_up(tile, 8); // keep panel starts 32-byte aligned
+    fill(C, C + rows, 0.0f);
+    for (int k0 = 0; k0 < padded; k0 += tile) {
+        const int k1 = min(padded, k0 + tile);
+        for (int i = 0; i < rows; ++i) {
+            const float* a_row = A + i * ld;
+            __m256 c_vec = _mm256_setzero_ps();
+            for (int k = k0; k < k1; k += 8) {
+                c_vec = _mm256_fmadd_ps(_mm256_load_ps(a_row + k), _mm256_load_ps(B + k), c_vec);
+            }
+            C[i] += hsum256(c_vec);
+        }
+    }
+}
+
+// 3e. Matrix-free Hilbert GEMV. A[i][j] = 1/(i+j+2) depends only on i+j, so the
+// entries are generated in registers instead of read from memory: an
+// approximate reciprocal (12 bits) refined by one Newton step, r' = r(2 - dr),
+// to ~23 bits. Memory traffic drops from n^2 floats to the n floats of B, and
+// the loop becomes compute-bound. Covers rows [row_begin, row_begin + rows).
+// Lanes past cols multiply B's zero padding, so no tail is needed.
+TARGET_AVX2
+inline __m256 recip_newton_avx2(__m256 d) {
+    __m256 r = _mm256_rcp_ps(d);
+    return _mm256_mul_ps(r, _mm256_fnmadd_ps(d, r, _mm256_set1_ps(2.0f)));
+}
+
+TARGET_AVX2
+void Mv_mult_hilbert(int row_begin, int rows, int cols, const float* B, float* C) {
+    const int padded = round_up(cols, 16);
+    const __m256 lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    for (int i = 0; i < rows; ++i) {
+        const float base = (float)(row_begin + i + 2);
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 16) {
+            // d = i + j + 2 for the 16 columns j = k .. k+15
+            __m256 d0 = _mm256_add_ps(_mm256_set1_ps(base + k), lane);
+            __m256 d1 = _mm256_add_ps(_mm256_set1_ps(base + k + 8), lane);
+            acc0 = _mm256_fmadd_ps(recip_newton_avx2(d0), _mm256_load_ps(B + k), acc0);
+            acc1 = _mm256_fmadd_ps(recip_newton_avx2(d1), _mm256_load_ps(B + k + 8), acc1);
+        }
+        C[i] = hsum256(_mm256_add_ps(acc0, acc1));
+    }
+}
+
+// 3f. Batched GEMV (skinny GEMM): C = A * B for nvec right-hand sides at once.
+// B is cols x nvec and C is rows x nvec, both row-major with leading dimensions
+// ldb/ldc padded to 16 (AlignedMatrix). Each A element is broadcast once and
+// applied to a panel of 8 * PANELS vectors, so A is streamed from memory once
+// for all vectors instead of once per vector. A block of ROWS rows stays
+// cache-resident while every panel of B is swept.
+template <int ROWS, int PANELS>
+TARGET_AVX2
+inline void Mv_mult_batched_panel(const float* A, int cols, size_t ld, const float* B, size_t ldb,
+                                  float* C, size_t ldc) {
+    __m256 acc[ROWS][PANELS];
+    for (int r = 0; r < ROWS; ++r) {
+        for (int p = 0; p < PANELS; ++p) acc[r][p] = _mm256_setzero_ps();
+    }
+    for (int j = 0; j < cols; ++j) {
+        __m256 b_vec[PANELS];
+        for (int p = 0; p < PANELS; ++p) b_vec[p] = _mm256_load_ps(B + j * ldb + 8 * p);
+        for (int r = 0; r < ROWS; ++r) {
+            __m256 a_val = _mm256_broadcast_ss(A + r * ld + j);
+            for (int p = 0; p < PANELS; ++p) acc[r][p] = _mm256_fmadd_ps(a_val, b_vec[p], acc[r][p]);
+        }
+    }
+    for (int r = 0; r < ROWS; ++r) {
+        for (int p = 0; p < PANELS; ++p) _mm256_store_ps(C + r * ldc + 8 * p, acc[r][p]);
+    }
+}
+
+// 16-vector panels, and an 8-vector panel for a remainder of at most 8 so
+// that no FMA is spent on more than 7 padding vectors
+template <int ROWS>
+TARGET_AVX2
+void Mv_mult_batched_block(const float* A, int cols, size_t ld, const float* B, int nvec,
+                           size_t ldb, float* C, size_t ldc) {
+    int v0 = 0;
+    for (; v0 + 8 < nvec; v0 += 16) {
+        Mv_mult_batched_panel<ROWS, 2>(A, cols, ld, B + v0, ldb, C + v0, ldc);
+    }
+    if (v0 < nvec) Mv_mult_batched_panel<ROWS, 1>(A, cols, ld, B + v0, ldb, C + v0, ldc);
+}
+
+// A single vector gains nothing from panels (7 of 8 lanes would be padding),
+// so it is gathered into a contiguous vector and run through Mv_mult_avx2.
+// Up to 8 vectors fit one 8-wide panel, which leaves registers for blocks of
+// 8 rows and so halves the sweeps over B.
+TARGET_AVX2
+void Mv_mult_batched(const float* A, int rows, int cols, size_t ld, const float* B, int nvec,
+                     size_t ldb, float* C, size_t ldc) {
+    if (nvec == 1) {
+        AlignedMatrix x(1, cols), y(1, rows);
+        for (int j = 0; j < cols; ++j) x.data()[j] = B[j * ldb];
+        Mv_mult_avx2(A, rows, cols, ld, x.data(), y.data());
+        for (int i = 0; i < rows; ++i) C[i * ldc] = y.data()[i];
+        return;
+    }
+    int i = 0;
+    if (nvec <= 8) {
+        for (; i <= rows - 8; i += 8) {
+            Mv_mult_batched_block<8>(A + i * ld, cols, ld, B, nvec, ldb, C + i * ldc, ldc);
+        }
+    }
+    for (; i <= rows - 4; i += 4) {
+        Mv_mult_batched_block<4>(A + i * ld, cols, ld, B, nvec, ldb, C + i * ldc, ldc);
+    }
+    for (; i < rows; ++i) {
+        Mv_mult_batched_block<1>(A + i * ld, cols, ld, B, nvec, ldb, C + i * ldc, ldc);
+    }
+}
+
+// 3g. Transposed product Y[0..cols) = A^T X for row-major A, without forming A^T.
+// A is still streamed row by row: row i contributes X[i] * A[i][:] to Y (an
+// AXPY), four rows per pass so Y is loaded and stored once per four rows.
+// Y must have room for cols rounded up to 8 (AlignedMatrix padding).
+TARGET_AVX2
+void Mv_mult_transposed(const float* A, int rows, int cols, size_t ld, const float* X, float* Y) {
+    const int padded = round_up(cols, 8);
+    fill(Y, Y + padded, 0.0f);
+    int i = 0;
+    for (; i <= rows - 4; i += 4) {
+        const float* a0 = A + i * ld;
+        const __m256 x0 = _mm256_set1_ps(X[i]), x1 = _mm256_set1_ps(X[i + 1]);
+        const __m256 x2 = _mm256_set1_ps(X[i + 2]), x3 = _mm256_set1_ps(X[i + 3]);
+        for (int k = 0; k < padded; k += 8) {
+            __m256 y = _mm256_load_ps(Y + k);
+            y = _mm256_fmadd_ps(_mm256_load_ps(a0 + k), x0, y);
+            y = _mm256_fmadd_ps(_mm256_load_ps(a0 + ld + k), x1, y);
+            y = _mm256_fmadd_ps(_mm256_load_ps(a0 + 2 * ld + k), x2, y);
+            y = _mm256_fmadd_ps(_mm256_load_ps(a0 + 3 * ld + k), x3, y);
+            _mm256_store_ps(Y + k, y);
+        }
+    }
+    for (; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        const __m256 xi = _mm256_set1_ps(X[i]);
+        for (int k = 0; k < padded; k += 8) {
+            _mm256_store_ps(Y + k, _mm256_fmadd_ps(_mm256_load_ps(a_row + k), xi, _mm256_load_ps(Y + k)));
+        }
+    }
+}
+
+// 3h. Fused C = A X and Z = A^T Y in one pass over A (BiCG/LSQR pairs). Each
+// A chunk loaded for the row dot products with X is reused for the AXPY of
+// Y[i] into Z, so A is read from memory once instead of twice. Four rows per
+// pass, as in Mv_mult_transposed. Z needs room for cols rounded up to 8.
+TARGET_AVX2
+void Mv_mult_fused(const float* A, int rows, int cols, size_t ld, const float* X, const float* Y,
+                   float* C, float* Z) {
+    const int padded = round_up(cols, 8);
+    fill(Z, Z + padded, 0.0f);
+    int i = 0;
+    for (; i <= rows - 4; i += 4) {
+        const float* a0 = A + i * ld;
+        const __m256 y0 = _mm256_set1_ps(Y[i]), y1 = _mm256_set1_ps(Y[i + 1]);
+        const __m256 y2 = _mm256_set1_ps(Y[i + 2]), y3 = _mm256_set1_ps(Y[i + 3]);
+        __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+        __m256 c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 8) {
+            const __m256 x = _mm256_load_ps(X + k);
+            const __m256 r0 = _mm256_load_ps(a0 + k), r1 = _mm256_load_ps(a0 + ld + k);
+            const __m256 r2 = _mm256_load_ps(a0 + 2 * ld + k), r3 = _mm256_load_ps(a0 + 3 * ld + k);
+            c0 = _mm256_fmadd_ps(r0, x, c0);
+            c1 = _mm256_fmadd_ps(r1, x, c1);
+            c2 = _mm256_fmadd_ps(r2, x, c2);
+            c3 = _mm256_fmadd_ps(r3, x, c3);
+            __m256 z = _mm256_load_ps(Z + k);
+            z = _mm256_fmadd_ps(r0, y0, z);
+            z = _mm256_fmadd_ps(r1, y1, z);
+            z = _mm256_fmadd_ps(r2, y2, z);
+            z = _mm256_fmadd_ps(r3, y3, z);
+            _mm256_store_ps(Z + k, z);
+        }
+        _mm_storeu_ps(C + i, hsum4_avx2(c0, c1, c2, c3));
+    }
+    for (; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        const __m256 yi = _mm256_set1_ps(Y[i]);
+        __m256 c_vec = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 8) {
+            const __m256 r = _mm256_load_ps(a_row + k);
+            c_vec = _mm256_fmadd_ps(r, _mm256_load_ps(X + k), c_vec);
+            _mm256_store_ps(Z + k, _mm256_fmadd_ps(r, yi, _mm256_load_ps(Z + k)));
+        }
+        C[i] = hsum256(c_vec);
+    }
+}
+
+// 3i. Symmetric matrix-vector product (SYMV) on packed upper-triangular storage.
+// Each stored off-diagonal A[i][j] (j > i) is read once and used twice: in the
+// dot product for Y[i] and in the AXPY update of Y[j]. Y[i] has received all
+// contributions from rows above it by the time row i finishes it.
+TARGET_AVX2
+void Mv_mult_symv_packed(const PackedSymmetricMatrix& AP, const float* X, float* Y) {
+    const int n = AP.size();
+    fill(Y, Y + n, 0.0f);
+    for (int i = 0; i < n; ++i) {
+        const float* a_row = AP.row(i) - i; // a_row[j] = A[i][j] for j >= i
+        const float xi = X[i];
+        const __m256 xi_vec = _mm256_set1_ps(xi);
+        __m256 dot = _mm256_setzero_ps();
+        int j = i + 1;
+        for (; j <= n - 8; j += 8) {
+            __m256 a_vec = _mm256_loadu_ps(a_row + j);
+            dot = _mm256_fmadd_ps(a_vec, _mm256_loadu_ps(X + j), dot);
+            _mm256_storeu_ps(Y + j, _mm256_fmadd_ps(a_vec, xi_vec, _mm256_loadu_ps(Y + j)));
+        }
+        float sum = a_row[i] * xi + hsum256(dot);
+        for (; j < n; ++j) {
+            sum += a_row[j] * X[j];
+            Y[j] += a_row[j] * xi;
+        }
+        Y[i] += sum;
+    }
+}
+
+// 3j. Banded GEMV on diagonal-major storage: Y[i] = sum_d diag(d)[i] * X[i+d].
+// Along a diagonal both diag(d)[i..i+7] and X[i+d..i+d+7] are contiguous, so
+// 8 rows are computed per register with one store, touching only the band:
+// O(n * (kl + ku + 1)) time and memory. Rows whose band reaches outside X
+// (the first kl and last ku or so) are done in scalar code.
+// X must be readable (and zero) up to n rounded up to 16, as B's padding is.
+TARGET_AVX2
+void Mv_mult_band(const BandMatrix& M, const float* X, float* Y) {
+    const int n = M.size(), kl = M.kl(), ku = M.ku();
+    auto scalar_row = [&](int i) {
+        float sum = 0.0f;
+        for (int d = max(-kl, -i); d <= min(ku, n - 1 - i); ++d) {
+            sum += M.diag(d)[i] * X[i + d];
+        }
+        Y[i] = sum;
+    };
+    const int vec_begin = min(n, round_up(kl, 8));
+    int vec_end = vec_begin;
+    while (vec_end + 8 <= n && vec_end + 8 + ku <= round_up(n, SIMD_PAD)) vec_end += 8;
+    for (int i = 0; i < vec_begin; ++i) scalar_row(i);
+    for (int i = vec_begin; i < vec_end; i += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int d = -kl; d <= ku; ++d) {
+            acc = _mm256_fmadd_ps(_mm256_load_ps(M.diag(d) + i), _mm256_loadu_ps(X + i + d), acc);
+        }
+        _mm256_storeu_ps(Y + i, acc);
+    }
+    for (int i = vec_end; i < n; ++i) scalar_row(i);
+}
+
+// Horizontal sum of 4 double lanes
+TARGET_AVX2
+inline double hsum256_pd(__m256d v) {
+    double lanes[4];
+    _mm256_storeu_pd(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// 3k. AVX2 GEMV templated on storage type T and accumulator type Acc:
+//   <float, float>   - pure fp32, i.e. Mv_mult_avx2
+//   <float, double>  - fp32 A and B, widened to fp64 before the FMA: same bytes
+//                      as fp32 but half the lanes per FMA
+//   <double, double> - fp64 storage and accumulation, twice the bytes of A
+// A row of the 1/(i+j+2) matrix sums thousands of terms spanning orders of
+// magnitude; at large n an fp32 accumulator drops the digits of the small ones.
+template <typename T, typename Acc>
+TARGET_AVX2
+void Mv_mult_avx2_typed(const T* A, int rows, int cols, size_t ld, const T* B, Acc* C) {
+    const int padded = round_up(cols, 8);
+    if constexpr (is_same<T, float>::value && is_same<Acc, float>::value) {
+        Mv_mult_avx2(A, rows, cols, ld, B, C);
+    } else if constexpr (is_same<T, float>::value && is_same<Acc, double>::value) {
+        for (int i = 0; i < rows; ++i) {
+            const float* a_row = A + i * ld;
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            for (int k = 0; k < padded; k += 8) {
+                __m256 a_vec = _mm256_load_ps(a_row + k);
+                __m256 b_vec = _mm256_load_ps(B + k);
+                acc0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(a_vec)),
+                                       _mm256_cvtps_pd(_mm256_castps256_ps128(b_vec)), acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(a_vec, 1)),
+                                       _mm256_cvtps_pd(_mm256_extractf128_ps(b_vec, 1)), acc1);
+            }
+            C[i] = hsum256_pd(_mm256_add_pd(acc0, acc1));
+        }
+    } else {
+        static_assert(is_same<T, double>::value && is_same<Acc, double>::value,
+                      "supported precisions: float/float, float/double, double/double");
+        for (int i = 0; i < rows; ++i) {
+            const double* a_row = A + i * ld;
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            for (int k = 0; k < padded; k += 8) {
+                acc0 = _mm256_fmadd_pd(_mm256_load_pd(a_row + k), _mm256_load_pd(B + k), acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_load_pd(a_row + k + 4), _mm256_load_pd(B + k + 4), acc1);
+            }
+            C[i] = hsum256_pd(_mm256_add_pd(acc0, acc1));
+        }
+    }
+}
+
+// Neumaier-compensated sum of the lanes of sum - comp (Kahan state vectors)
+inline float compensated_lane_sum(const float* sums, const float* comps, int lanes) {
+    float total = 0.0f, carry = 0.0f;
+    for (int l = 0; l < 2 * lanes; ++l) {
+        float x = l < lanes ? sums[l] : -comps[l - lanes];
+        float t = total + x;
+        carry += fabs(total) >= fabs(x) ? (total - t) + x : (x - t) + total;
+        total = t;
+    }
+    return total + carry;
+}
+
+// 3l. Kahan-compensated AVX2 GEMV. Every lane keeps a running compensation
+// term holding the low-order bits its additions lost, so each row sum is
+// accurate to a few fp32 ulps independent of n, where the plain FMA kernel's
+// error grows with n. Per step the dependency chain is fmsub, add, sub, sub
+// instead of one FMA, so two independent sum/compensation pairs are kept in flight.
+TARGET_AVX2
+void Mv_mult_kahan(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 16);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+        __m256 comp0 = _mm256_setzero_ps(), comp1 = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 16) {
+            __m256 y0 = _mm256_fmsub_ps(_mm256_load_ps(a_row + k), _mm256_load_ps(B + k), comp0);
+            __m256 y1 = _mm256_fmsub_ps(_mm256_load_ps(a_row + k + 8), _mm256_load_ps(B + k + 8), comp1);
+            __m256 t0 = _mm256_add_ps(sum0, y0);
+            __m256 t1 = _mm256_add_ps(sum1, y1);
+            comp0 = _mm256_sub_ps(_mm256_sub_ps(t0, sum0), y0);
+            comp1 = _mm256_sub_ps(_mm256_sub_ps(t1, sum1), y1);
+            sum0 = t0;
+            sum1 = t1;
+        }
+        alignas(32) float sums[16], comps[16];
+        _mm256_store_ps(sums, sum0);
+        _mm256_store_ps(sums + 8, sum1);
+        _mm256_store_ps(comps, comp0);
+        _mm256_store_ps(comps + 8, comp1);
+        C[i] = compensated_lane_sum(sums, comps, 16);
+    }
+}
+
+// 3m. Pairwise-summation AVX2 GEMV. Plain FMA accumulation over blocks of
+// PAIRWISE_BLOCK columns, and block sums merged as a binary tree via a
+// counter-indexed stack (levels[l] holds the sum of 2^l blocks), so error grows
+// with log(n) instead of n at almost the plain kernel's cost.
+const int PAIRWISE_BLOCK = 128;
+
+TARGET_AVX2
+void Mv_mult_pairwise(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 16);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        __m256 levels[32];
+        unsigned blocks = 0;
+        for (int k0 = 0; k0 < padded; k0 += PAIRWISE_BLOCK) {
+            const int k_end = min(padded, k0 + PAIRWISE_BLOCK);
+            __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+            for (int k = k0; k < k_end; k += 16) {
+                acc0 = _mm256_fmadd_ps(_mm256_load_ps(a_row + k), _mm256_load_ps(B + k), acc0);
+                acc1 = _mm256_fmadd_ps(_mm256_load_ps(a_row + k + 8), _mm256_load_ps(B + k + 8), acc1);
+            }
+            // Adding one block to the counter carries through every full level
+            __m256 carry = _mm256_add_ps(acc0, acc1);
+            int l = 0;
+            for (; blocks & (1u << l); ++l) carry = _mm256_add_ps(levels[l], carry);
+            levels[l] = carry;
+            ++blocks;
+        }
+        // Fold the partial levels, smallest first, then the lanes as a tree
+        __m256 total = _mm256_setzero_ps();
+        for (int l = 0; (blocks >> l) != 0; ++l) {
+            if (blocks & (1u << l)) total = _mm256_add_ps(total, levels[l]);
+        }
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(total), _mm256_extractf128_ps(total, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        C[i] = _mm_cvtss_f32(_mm_add_ss(half, _mm_movehdup_ps(half)));
+    }
+}
+
+// --- Per-ISA Kernels (selected at runtime) ---
+
+// Generic fallback for any x86-64 CPU
+void Mv_mult_scalar(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        float sum = 0.0f;
+        for (int k = 0; k < cols; ++k) {
+            sum += a_row[k] * B[k];
         }
         C[i] = sum;
     }
 }
 
+// SSE4.2: 4 floats per multiply-add, horizontal sum with dpps
+TARGET_SSE42
+void Mv_mult_sse42(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 4);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        __m128 c_vec = _mm_setzero_ps();
+        for (int k = 0; k < padded; k += 4) {
+            c_vec = _mm_add_ps(c_vec, _mm_mul_ps(_mm_load_ps(a_row + k), _mm_load_ps(B + k)));
+        }
+        C[i] = _mm_cvtss_f32(_mm_dp_ps(c_vec, _mm_set1_ps(1.0f), 0xF1));
+    }
+}
+
+// Horizontal sum of the 16 lanes. Goes through memory rather than
+// _mm512_reduce_add_ps/_mm512_extractf64x4_pd, which trip -Wmaybe-uninitialized
+// inside GCC 12's own headers.
+TARGET_AVX512
+inline float hsum512(__m512 v) {
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, v);
+    __m256 s8 = _mm256_add_ps(_mm256_load_ps(lanes), _mm256_load_ps(lanes + 8));
+    __m128 s4 = _mm_add_ps(_mm256_castps256_ps128(s8), _mm256_extractf128_ps(s8, 1));
+    s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
+    s4 = _mm_add_ss(s4, _mm_movehdup_ps(s4));
+    return _mm_cvtss_f32(s4);
+}
+
+// AVX-512: 16 floats per FMA. Rows are padded to a multiple of 16, so the
+// n % 16 remainder is covered by the zeroed padding and needs no tail code.
+TARGET_AVX512
+void Mv_mult_avx512(const float* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 16);
+    for (int i = 0; i < rows; ++i) {
+        const float* a_row = A + i * ld;
+        __m512 c_vec = _mm512_setzero_ps();
+        for (int k = 0; k < padded; k += 16) {
+            __m512 a_vec = _mm512_load_ps(a_row + k);
+            __m512 b_vec = _mm512_load_ps(B + k);
+            c_vec = _mm512_fmadd_ps(a_vec, b_vec, c_vec);
+        }
+        C[i] = hsum512(c_vec);
+    }
+}
+
+bool cpu_supports_isa(const string& isa) {
+    __builtin_cpu_init();
+    if (isa == "scalar") return true;
+    if (isa == "sse4.2") return __builtin_cpu_supports("sse4.2");
+    if (isa == "avx2") return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (isa == "avx512") return __builtin_cpu_supports("avx512f");
+    if (isa == "f16c") return cpu_supports_isa("avx2") && __builtin_cpu_supports("f16c");
+    if (isa == "avx512bf16") return cpu_supports_isa("avx512") && __builtin_cpu_supports("avx512bf16");
+    if (isa == "avx512vnni") {
+        return cpu_supports_isa("avx512") && __builtin_cpu_supports("avx512bw") &&
+               __builtin_cpu_supports("avx512vnni");
+    }
+    return false;
+}
+
+// Returns the widest instruction set this CPU can run, fastest first
+string select_isa() {
+    for (const char* isa : {"avx512", "avx2", "sse4.2"}) {
+        if (cpu_supports_isa(isa)) return isa;
+    }
+    return "scalar";
+}
+
+MvKernel kernel_for_isa(const string& isa) {
+    if (isa == "avx512") return Mv_mult_avx512;
+    if (isa == "avx2") return Mv_mult_avx2;
+    if (isa == "sse4.2") return Mv_mult_sse42;
+    return Mv_mult_scalar;
+}
+
+// Optimization types whose kernels are written directly in AVX2/FMA
+bool requires_avx2(const string& opt_type) {
+    return opt_type.compare(0, 4, "avx2") == 0 ||  // avx2, avx2x*, avx2r*
+           opt_type == "blocked" || opt_type == "hilbert" || opt_type == "batched" ||
+           opt_type == "transpose" || opt_type == "transpose_parallel" || opt_type == "fused" ||
+           opt_type == "symv" || opt_type == "band" || opt_type == "fp32" || opt_type == "mixed" ||
+           opt_type == "fp64" || opt_type == "kahan" || opt_type == "pairwise";
+}
+
+// Optimization types that need the dense n x n A; the others generate A on the
+// fly or keep it in their own structured or sparse storage
+bool uses_dense_matrix(const string& opt_type) {
+    return opt_type != "hilbert" && opt_type != "hankel" && opt_type != "symv" &&
+           opt_type != "csr" && opt_type != "sell" && opt_type != "bsr" && opt_type != "bcsr" &&
+           opt_type != "band" && opt_type != "fp16" && opt_type != "bf16" &&
+           opt_type != "int8" && opt_type != "fp64";
+}
+
+// 4. Multi-threaded SIMD (each worker owns a contiguous block of rows)
+// If thread_us is given, each worker's own kernel time is stored in thread_us[tid].
+void Mv_mult_parallel(const float* A, int rows, int cols, size_t ld, const float* B, float* C,
+                      ThreadPool& pool, MvKernel kernel, double* thread_us = nullptr) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(rows, tid, pool.size(), begin, end);
+        double start = microtime();
+        kernel(A + begin * ld, end - begin, cols, ld, B, C + begin);
+        if (thread_us) thread_us[tid] = microtime() - start;
+    });
+}
+
+// 4b. Multi-threaded A^T X. Each worker runs Mv_mult_transposed on its block of
+// rows into its own row of 'partials' (pool.size() x cols), then the partial
+// outputs are summed, with the columns split across the same workers.
+TARGET_AVX2
+void sum_partials_avx2(const AlignedMatrix& partials, int k_begin, int k_end, float* Y) {
+    for (int k = k_begin; k < k_end; k += 8) {
+        __m256 y = _mm256_load_ps(partials.row(0) + k);
+        for (int p = 1; p < partials.rows(); ++p) {
+            y = _mm256_add_ps(y, _mm256_load_ps(partials.row(p) + k));
+        }
+        _mm256_store_ps(Y + k, y);
+    }
+}
+
+void Mv_mult_transposed_parallel(const float* A, int rows, int cols, size_t ld, const float* X,
+                                 float* Y, ThreadPool& pool, AlignedMatrix& partials) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(rows, tid, pool.size(), begin, end);
+        Mv_mult_transposed(A + begin * ld, end - begin, cols, ld, X + begin, partials.row(tid));
+    });
+    const int chunks = round_up(cols, SIMD_PAD) / SIMD_PAD;
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(chunks, tid, pool.size(), begin, end);
+        sum_partials_avx2(partials, begin * SIMD_PAD, end * SIMD_PAD, Y);
+    });
+}
+
+// --- Sparse Kernels (CSR) ---
+// Scalar SpMV over rows [row_begin, row_end)
+void Mv_mult_csr_scalar(const CsrMatrix& S, int row_begin, int row_end, const float* X, float* Y) {
+    for (int i = row_begin; i < row_end; ++i) {
+        float sum = 0.0f;
+        for (int p = S.row_ptr[i]; p < S.row_ptr[i + 1]; ++p) {
+            sum += S.values[p] * X[S.col_idx[p]];
+        }
+        Y[i] = sum;
+    }
+}
+
+// AVX2 SpMV: 8 nonzeros per step, X entries fetched with a gather
+TARGET_AVX2
+void Mv_mult_csr_avx2(const CsrMatrix& S, int row_begin, int row_end, const float* X, float* Y) {
+    const int* col_idx = S.col_idx.data();
+    const float* values = S.values.data();
+    for (int i = row_begin; i < row_end; ++i) {
+        int p = S.row_ptr[i];
+        const int p_end = S.row_ptr[i + 1];
+        __m256 acc = _mm256_setzero_ps();
+        for (; p <= p_end - 8; p += 8) {
+            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col_idx + p));
+            __m256 x_vec = _mm256_i32gather_ps(X, idx, sizeof(float));
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(values + p), x_vec, acc);
+        }
+        float sum = hsum256(acc);
+        for (; p < p_end; ++p) {
+            sum += values[p] * X[col_idx[p]];
+        }
+        Y[i] = sum;
+    }
+}
+
+// Splits [0, count) into nparts blocks of about equal work, where prefix[i] is
+// the work before item i (prefix has count + 1 entries, e.g. CSR row_ptr).
+void balanced_range(const vector<int>& prefix, int count, int part, int nparts, int& begin, int& end) {
+    auto item_at = [&](int q) {
+        long long target = (long long)prefix[count] * q / nparts;
+        return min(count, (int)(lower_bound(prefix.begin(), prefix.begin() + count + 1, target) -
+                                prefix.begin()));
+    };
+    begin = part == 0 ? 0 : item_at(part);
+    end = part == nparts - 1 ? count : item_at(part + 1);
+}
+
+// 5. Multi-threaded CSR SpMV with nnz-balanced row blocks
+void Mv_mult_csr(const CsrMatrix& S, const float* X, float* Y, ThreadPool& pool, bool use_avx2) {
+    pool.run([&](int tid) {
+        int begin, end;
+        balanced_range(S.row_ptr, S.rows, tid, pool.size(), begin, end); // equal nnz per worker
+        if (use_avx2) {
+            Mv_mult_csr_avx2(S, begin, end, X, Y);
+        } else {
+            Mv_mult_csr_scalar(S, begin, end, X, Y);
+        }
+    });
+}
+
+// --- Sparse Kernels (SELL-C-sigma) ---
+// Each kernel handles chunks [chunk_begin, chunk_end); lane l of chunk c
+// accumulates the row in slot c * C + l and scatters it to its original row.
+void Mv_mult_sell_scalar(const SellMatrix& M, int chunk_begin, int chunk_end, const float* X, float* Y) {
+    const int C = M.chunk_size;
+    for (int c = chunk_begin; c < chunk_end; ++c) {
+        for (int lane = 0; lane < C; ++lane) {
+            const int i = M.row_perm[c * C + lane];
+            if (i < 0) continue;
+            float sum = 0.0f;
+            for (int k = 0; k < M.chunk_len[c]; ++k) {
+                size_t slot = M.chunk_ptr[c] + (size_t)k * C + lane;
+                sum += M.values[slot] * X[M.col_idx[slot]];
+            }
+            Y[i] = sum;
+        }
+    }
+}
+
+// C = 8: one AVX2 register holds entry k of all 8 rows of a chunk
+TARGET_AVX2
+void Mv_mult_sell8_avx2(const SellMatrix& M, int chunk_begin, int chunk_end, const float* X, float* Y) {
+    for (int c = chunk_begin; c < chunk_end; ++c) {
+        const int* cols = M.col_idx.data() + M.chunk_ptr[c];
+        const float* vals = M.values.data() + M.chunk_ptr[c];
+        __m256 acc = _mm256_setzero_ps();
+        for (int k = 0; k < M.chunk_len[c]; ++k) {
+            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cols + 8 * k));
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(vals + 8 * k),
+                                  _mm256_i32gather_ps(X, idx, sizeof(float)), acc);
+        }
+        float sums[8];
+        _mm256_storeu_ps(sums, acc);
+        for (int lane = 0; lane < 8; ++lane) {
+            const int i = M.row_perm[c * 8 + lane];
+            if (i >= 0) Y[i] = sums[lane];
+        }
+    }
+}
+
+// C = 16: the AVX-512 version of the above
+TARGET_AVX512
+void Mv_mult_sell16_avx512(const SellMatrix& M, int chunk_begin, int chunk_end, const float* X, float* Y) {
+    for (int c = chunk_begin; c < chunk_end; ++c) {
+        const int* cols = M.col_idx.data() + M.chunk_ptr[c];
+        const float* vals = M.values.data() + M.chunk_ptr[c];
+        __m512 acc = _mm512_setzero_ps();
+        for (int k = 0; k < M.chunk_len[c]; ++k) {
+            __m512i idx = _mm512_loadu_si512(cols + 16 * k);
+            // Masked form with an explicit zero source: the unmasked gather
+            // trips -Wmaybe-uninitialized inside GCC 12's headers
+            __m512 x_vec = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, idx, X, sizeof(float));
+            acc = _mm512_fmadd_ps(_mm512_loadu_ps(vals + 16 * k), x_vec, acc);
+        }
+        alignas(64) float sums[16];
+        _mm512_store_ps(sums, acc);
+        for (int lane = 0; lane < 16; ++lane) {
+            const int i = M.row_perm[c * 16 + lane];
+            if (i >= 0) Y[i] = sums[lane];
+        }
+    }
+}
+
+// SELL chunk size matching the widest SIMD kernel for an instruction set
+int sell_chunk_size_for_isa(const string& isa) {
+    return isa == "avx512" ? 16 : 8;
+}
+
+// 5b. Multi-threaded SELL-C-sigma SpMV; chunks split so each worker gets an
+// equal share of stored (padded) entries
+void Mv_mult_sell(const SellMatrix& M, const float* X, float* Y, ThreadPool& pool, const string& isa) {
+    pool.run([&](int tid) {
+        int begin, end;
+        balanced_range(M.chunk_ptr, M.num_chunks(), tid, pool.size(), begin, end);
+        if (isa == "avx512" && M.chunk_size == 16) {
+            Mv_mult_sell16_avx512(M, begin, end, X, Y);
+        } else if ((isa == "avx2" || isa == "avx512") && M.chunk_size == 8) {
+            Mv_mult_sell8_avx2(M, begin, end, X, Y);
+        } else {
+            Mv_mult_sell_scalar(M, begin, end, X, Y);
+        }
+    });
+}
+
+// --- Sparse Kernels (BSR) ---
+// Each kernel handles block rows [I_begin, I_end). X must be readable (and
+// zero) up to cols rounded up to the block size, which B's padding provides.
+void Mv_mult_bsr_scalar(const BsrMatrix& M, int I_begin, int I_end, const float* X, float* Y) {
+    const int b = M.block;
+    for (int I = I_begin; I < I_end; ++I) {
+        float sums[8] = {0.0f};
+        for (int p = M.block_row_ptr[I]; p < M.block_row_ptr[I + 1]; ++p) {
+            const float* blk = M.values.data() + (size_t)p * b * b;
+            const float* x = X + M.block_col[p] * b;
+            for (int r = 0; r < b; ++r) {
+                for (int q = 0; q < b; ++q) sums[r] += blk[r * b + q] * x[q];
+            }
+        }
+        for (int r = 0; r < b && I * b + r < M.rows; ++r) Y[I * b + r] = sums[r];
+    }
+}
+
+// 4x4 blocks: two rows per AVX2 register, X chunk duplicated into both halves
+TARGET_AVX2
+void Mv_mult_bsr4_avx2(const BsrMatrix& M, int I_begin, int I_end, const float* X, float* Y) {
+    for (int I = I_begin; I < I_end; ++I) {
+        __m256 acc01 = _mm256_setzero_ps(), acc23 = _mm256_setzero_ps();
+        for (int p = M.block_row_ptr[I]; p < M.block_row_ptr[I + 1]; ++p) {
+            const float* blk = M.values.data() + (size_t)p * 16;
+            const __m256 x_vec = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(X + M.block_col[p] * 4));
+            acc01 = _mm256_fmadd_ps(_mm256_loadu_ps(blk), x_vec, acc01);
+            acc23 = _mm256_fmadd_ps(_mm256_loadu_ps(blk + 8), x_vec, acc23);
+        }
+        __m256 h = _mm256_hadd_ps(acc01, acc23);  // r0 r0 r2 r2 | r1 r1 r3 r3
+        h = _mm256_hadd_ps(h, h);                 // r0 r2 r0 r2 | r1 r3 r1 r3
+        __m128 sums = _mm_unpacklo_ps(_mm256_castps256_ps128(h), _mm256_extractf128_ps(h, 1));
+        float out[4];
+        _mm_storeu_ps(out, sums);
+        for (int r = 0; r < 4 && I * 4 + r < M.rows; ++r) Y[I * 4 + r] = out[r];
+    }
+}
+
+// 8x8 blocks: one register per block row, the same X chunk reused by all 8 rows
+// (the Mv_mult_avx2 inner loop applied to a dense block)
+TARGET_AVX2
+void Mv_mult_bsr8_avx2(const BsrMatrix& M, int I_begin, int I_end, const float* X, float* Y) {
+    for (int I = I_begin; I < I_end; ++I) {
+        __m256 acc[8];
+        for (int r = 0; r < 8; ++r) acc[r] = _mm256_setzero_ps();
+        for (int p = M.block_row_ptr[I]; p < M.block_row_ptr[I + 1]; ++p) {
+            const float* blk = M.values.data() + (size_t)p * 64;
+            const __m256 x_vec = _mm256_loadu_ps(X + M.block_col[p] * 8);
+            for (int r = 0; r < 8; ++r) {
+                acc[r] = _mm256_fmadd_ps(_mm256_loadu_ps(blk + r * 8), x_vec, acc[r]);
+            }
+        }
+        float out[8];
+        _mm_storeu_ps(out, hsum4_avx2(acc[0], acc[1], acc[2], acc[3]));
+        _mm_storeu_ps(out + 4, hsum4_avx2(acc[4], acc[5], acc[6], acc[7]));
+        for (int r = 0; r < 8 && I * 8 + r < M.rows; ++r) Y[I * 8 + r] = out[r];
+    }
+}
+
+// 5c. Multi-threaded BSR SpMV; block rows split for an equal number of blocks
+void Mv_mult_bsr(const BsrMatrix& M, const float* X, float* Y, ThreadPool& pool, bool use_avx2) {
+    pool.run([&](int tid) {
+        int begin, end;
+        balanced_range(M.block_row_ptr, M.block_rows, tid, pool.size(), begin, end);
+        if (use_avx2 && M.block == 4) {
+            Mv_mult_bsr4_avx2(M, begin, end, X, Y);
+        } else if (use_avx2 && M.block == 8) {
+            Mv_mult_bsr8_avx2(M, begin, end, X, Y);
+        } else {
+            Mv_mult_bsr_scalar(M, begin, end, X, Y);
+        }
+    });
+}
+
+// --- Reduced-Precision Kernels ---
+// A's bytes dominate the memory traffic of every dense kernel, so keeping it in
+// a narrower format raises the bandwidth-bound ceiling in proportion. Products
+// are still accumulated in fp32.
+using HalfMatrix = AlignedMatrixOf<uint16_t>; // IEEE binary16 bit patterns
+using Bf16Matrix = AlignedMatrixOf<uint16_t>; // bfloat16: upper half of an fp32
+
+// fp32 -> bf16 with round-to-nearest-even (the inputs here are finite)
+inline uint16_t float_to_bf16(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+// 6. FP16 storage: each 8 halves of A are widened to fp32 in-register with
+// F16C's vcvtph2ps right before the FMA, halving the bytes read per flop.
+// fp16 keeps 11 significant bits, and values below 6.1e-5 (test matrix
+// entries with i + j > ~16k) become subnormals with fewer.
+TARGET_F16C
+void Mv_mult_fp16(const uint16_t* A, int rows, int cols, size_t ld, const float* B, float* C) {
+    const int padded = round_up(cols, 16);
+    for (int i = 0; i < rows; ++i) {
+        const uint16_t* a_row = A + i * ld;
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 16) {
+            __m256 a0 = _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(a_row + k)));
+            __m256 a1 = _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(a_row + k + 8)));
+            acc0 = _mm256_fmadd_ps(a0, _mm256_load_ps(B + k), acc0);
+            acc1 = _mm256_fmadd_ps(a1, _mm256_load_ps(B + k + 8), acc1);
+        }
+        C[i] = hsum256(_mm256_add_ps(acc0, acc1));
+    }
+}
+
+// 6b. BF16 storage of both A and B. bf16 keeps fp32's 8-bit exponent (only
+// the mantissa shrinks to 8 bits), so the small 1/(i+j+2) entries of large
+// matrices stay normal. With AVX512-BF16, vdpbf16ps multiplies 32 bf16 pairs
+// and adds adjacent products into 16 fp32 lanes in one instruction.
+TARGET_AVX512_BF16
+void Mv_mult_bf16_avx512(const uint16_t* A, int rows, int cols, size_t ld, const uint16_t* B, float* C) {
+    const int padded = round_up(cols, 32);
+    for (int i = 0; i < rows; ++i) {
+        const uint16_t* a_row = A + i * ld;
+        __m512 acc = _mm512_setzero_ps();
+        for (int k = 0; k < padded; k += 32) {
+            __m512bh a_vec = (__m512bh)_mm512_load_si512(a_row + k);
+            __m512bh b_vec = (__m512bh)_mm512_load_si512(B + k);
+            acc = _mm512_dpbf16_ps(acc, a_vec, b_vec);
+        }
+        C[i] = hsum512(acc);
+    }
+}
+
+// Without AVX512-BF16 a bf16 widens to fp32 by zero-extending to 32 bits and
+// shifting left by 16; the products then go through the usual fp32 FMA.
+TARGET_AVX2
+inline __m256 bf16x8_to_ps(const uint16_t* p) {
+    __m256i wide = _mm256_cvtepu16_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(p)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16));
+}
+
+TARGET_AVX2
+void Mv_mult_bf16_avx2(const uint16_t* A, int rows, int cols, size_t ld, const uint16_t* B, float* C) {
+    const int padded = round_up(cols, 16);
+    for (int i = 0; i < rows; ++i) {
+        const uint16_t* a_row = A + i * ld;
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 16) {
+            acc0 = _mm256_fmadd_ps(bf16x8_to_ps(a_row + k), bf16x8_to_ps(B + k), acc0);
+            acc1 = _mm256_fmadd_ps(bf16x8_to_ps(a_row + k + 8), bf16x8_to_ps(B + k + 8), acc1);
+        }
+        C[i] = hsum256(_mm256_add_ps(acc0, acc1));
+    }
+}
+
+// 6c. INT8 GEMV. Each row of A is quantized to int8 with its own fp32 scale,
+// A[i][j] ~ scale[i] * q[i][j]. B is quantized in groups of INT8_GROUP
+// columns, each with its own scale: one scale for all of B = 1/(j+2) would
+// round most of its tail to zero. Dot products run in exact integer
+// arithmetic per group, are scaled by the group's B scale in fp32, and the
+// row sum is dequantized once by A's scale. A takes a quarter of its fp32 bytes.
+const int INT8_GROUP = 32;
+
+// Symmetric quantization to [-127, 127]; returns the scale (0 for a zero row)
+float quantize_int8(const float* x, int n, int8_t* q) {
+    float max_abs = 0.0f;
+    for (int j = 0; j < n; ++j) max_abs = max(max_abs, fabs(x[j]));
+    const float scale = max_abs / 127.0f;
+    const float inv = max_abs > 0.0f ? 127.0f / max_abs : 0.0f;
+    for (int j = 0; j < n; ++j) {
+        q[j] = static_cast<int8_t>(max(-127L, min(127L, lrintf(x[j] * inv))));
+    }
+    return scale;
+}
+
+// Quantizes B group by group. Both kernels accumulate four adjacent byte
+// products per 32-bit lane, so the scales are stored once per lane
+// (lane_scale[k / 4] applies to B[k .. k+3]), ready for a vector load.
+// lane_scale must hold round_up(n, 64) / 4 zero-initialized floats.
+void quantize_int8_groups(const float* x, int n, int8_t* q, float* lane_scale) {
+    for (int g = 0; g < n; g += INT8_GROUP) {
+        float scale = quantize_int8(x + g, min(INT8_GROUP, n - g), q + g);
+        fill(lane_scale + g / 4, lane_scale + (g + INT8_GROUP) / 4, scale);
+    }
+}
+
+// The byte multipliers take one unsigned and one signed operand, so both
+// kernels feed |a| and b with a's sign applied. The two operands then stay
+// within [-127, 127], and vpmaddubsw's pairwise 16-bit sums (at most
+// 2 * 127 * 127) can never saturate. Each 32-bit lane's group dot product is
+// at most 4 * 127 * 127, so its conversion to fp32 is exact.
+TARGET_AVX2
+void Mv_mult_int8_avx2(const int8_t* A, const float* scale, int rows, int cols, size_t ld,
+                       const int8_t* B, const float* b_lane_scale, float* C) {
+    const int padded = round_up(cols, 32);
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (int i = 0; i < rows; ++i) {
+        const int8_t* a_row = A + i * ld;
+        __m256 acc = _mm256_setzero_ps();
+        for (int k = 0; k < padded; k += 32) {
+            __m256i a_vec = _mm256_load_si256(reinterpret_cast<const __m256i*>(a_row + k));
+            __m256i b_vec = _mm256_load_si256(reinterpret_cast<const __m256i*>(B + k));
+            __m256i pairs = _mm256_maddubs_epi16(_mm256_abs_epi8(a_vec), _mm256_sign_epi8(b_vec, a_vec));
+            __m256i dot = _mm256_madd_epi16(pairs, ones);
+            acc = _mm256_fmadd_ps(_mm256_cvtepi32_ps(dot), _mm256_loadu_ps(b_lane_scale + k / 4), acc);
+        }
+        C[i] = scale[i] * hsum256(acc);
+    }
+}
+
+// AVX512-VNNI: vpdpbusd multiplies 64 byte pairs and adds each group of four
+// products straight into a 32-bit lane, with no 16-bit intermediate.
+TARGET_AVX512_VNNI
+void Mv_mult_int8_vnni(const int8_t* A, const float* scale, int rows, int cols, size_t ld,
+                       const int8_t* B, const float* b_lane_scale, float* C) {
+    const int padded = round_up(cols, 64);
+    const __m512i zero = _mm512_setzero_si512();
+    for (int i = 0; i < rows; ++i) {
+        const int8_t* a_row = A + i * ld;
+        __m512 acc = _mm512_setzero_ps();
+        for (int k = 0; k < padded; k += 64) {
+            __m512i a_vec = _mm512_load_si512(a_row + k);
+            __m512i b_vec = _mm512_load_si512(B + k);
+            __m512i b_signed = _mm512_mask_sub_epi8(b_vec, _mm512_movepi8_mask(a_vec), zero, b_vec);
+            __m512i dot = _mm512_dpbusd_epi32(zero, _mm512_abs_epi8(a_vec), b_signed);
+            // Masked form with a zero source: the unmasked one reads an
+            // undefined register, which GCC 12 flags as maybe-uninitialized
+            __m512 dot_ps = _mm512_mask_cvtepi32_ps(_mm512_setzero_ps(), 0xFFFF, dot);
+            acc = _mm512_fmadd_ps(dot_ps, _mm512_loadu_ps(b_lane_scale + k / 4), acc);
+        }
+        C[i] = scale[i] * hsum512(acc);
+    }
+}
+
+// --- Matrix Initialization ---
+// Fills rows [begin, end) with the test matrix A[i][j] = 1/(i+j+2) (Mv.cpp's
+// InitMatrix) and zeroes their padding columns.
+void init_matrix_rows(AlignedMatrix& A, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float* a_row = A.row(i);
+        for (int j = 0; j < A.cols(); ++j) {
+            a_row[j] = 1.0f / (i + j + 2.0f);
+        }
+        fill(a_row + A.cols(), a_row + A.ld(), 0.0f);
+    }
+}
+
+// AVX2 version, 8 columns per step. Uses a true division rather than
+// rcp + Newton so that A stays bit-identical to Mv.cpp's; at these sizes the
+// loop is bound by store bandwidth, not by the divider.
+TARGET_AVX2
+void fill_test_row_avx2(float* a_row, int i, int cols, size_t ld) {
+    const __m256 lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (int j = 0; j < round_up(cols, 8); j += 8) {
+        __m256 d = _mm256_add_ps(_mm256_set1_ps((float)(i + j + 2)), lane);
+        _mm256_store_ps(a_row + j, _mm256_div_ps(one, d));
+    }
+    fill(a_row + cols, a_row + ld, 0.0f);
+}
+
+void init_matrix_rows_avx2(AlignedMatrix& A, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        fill_test_row_avx2(A.row(i), i, A.cols(), A.ld());
+    }
+}
+
+// Multi-threaded initialization with the same row blocks as Mv_mult_parallel,
+// so each worker first-touches (and, with a pinned pool, places on its own
+// NUMA node) exactly the rows it later multiplies.
+void init_matrix(AlignedMatrix& A, ThreadPool& pool) {
+    const bool use_avx2 = cpu_supports_isa("avx2");
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(A.rows(), tid, pool.size(), begin, end);
+        if (use_avx2) {
+            init_matrix_rows_avx2(A, begin, end);
+        } else {
+            init_matrix_rows(A, begin, end);
+        }
+    });
+}
+
+// fp16 copy of the test matrix: each fp32 value 1/(i+j+2), computed as above,
+// is rounded to the nearest half. Rows are split across the pool as in init_matrix.
+TARGET_F16C
+void init_half_matrix_rows(HalfMatrix& A, int begin, int end) {
+    const __m256 lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (int i = begin; i < end; ++i) {
+        uint16_t* a_row = A.row(i);
+        for (int j = 0; j < round_up(A.cols(), 8); j += 8) {
+            __m256 d = _mm256_add_ps(_mm256_set1_ps((float)(i + j + 2)), lane);
+            __m128i h = _mm256_cvtps_ph(_mm256_div_ps(one, d), _MM_FROUND_TO_NEAREST_INT);
+            _mm_store_si128(reinterpret_cast<__m128i*>(a_row + j), h);
+        }
+        fill(a_row + A.cols(), a_row + A.ld(), (uint16_t)0);
+    }
+}
+
+void init_half_matrix(HalfMatrix& A, ThreadPool& pool) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(A.rows(), tid, pool.size(), begin, end);
+        init_half_matrix_rows(A, begin, end);
+    });
+}
+
+// bf16 copy of the test matrix: each row is built in fp32 as init_matrix does
+// and then rounded, rows split across the pool. Uses the AVX2 row generator
+// unconditionally: main only runs bf16 on CPUs with AVX2.
+void init_bf16_matrix(Bf16Matrix& A, ThreadPool& pool) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(A.rows(), tid, pool.size(), begin, end);
+        AlignedMatrix row(1, A.cols());
+        for (int i = begin; i < end; ++i) {
+            fill_test_row_avx2(row.data(), i, A.cols(), row.ld());
+            uint16_t* a_row = A.row(i);
+            for (int j = 0; j < A.cols(); ++j) a_row[j] = float_to_bf16(row.data()[j]);
+            fill(a_row + A.cols(), a_row + A.ld(), (uint16_t)0);
+        }
+    });
+}
+
+// int8 copy of the test matrix: each fp32 row is built as init_matrix does and
+// quantized with its own scale, rows split across the pool. AVX2 only, as
+// for bf16.
+void init_int8_matrix(AlignedMatrixOf<int8_t>& A, float* scale, ThreadPool& pool) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(A.rows(), tid, pool.size(), begin, end);
+        AlignedMatrix row(1, A.cols());
+        for (int i = begin; i < end; ++i) {
+            fill_test_row_avx2(row.data(), i, A.cols(), row.ld());
+            scale[i] = quantize_int8(row.data(), A.cols(), A.row(i));
+            fill(A.row(i) + A.cols(), A.row(i) + A.ld(), (int8_t)0);
+        }
+    });
+}
+
+// fp64 copy of the test matrix, 1/(i+j+2) divided in double, rows split
+// across the pool
+void init_double_matrix(AlignedMatrixOf<double>& A, ThreadPool& pool) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(A.rows(), tid, pool.size(), begin, end);
+        for (int i = begin; i < end; ++i) {
+            double* a_row = A.row(i);
+            for (int j = 0; j < A.cols(); ++j) a_row[j] = 1.0 / (i + j + 2.0);
+            fill(a_row + A.cols(), a_row + A.ld(), 0.0);
+        }
+    });
+}
+
+// Fills the packed upper triangle with 1/(i+j+2), rows split across the pool
+void init_packed_matrix(PackedSymmetricMatrix& AP, ThreadPool& pool) {
+    pool.run([&](int tid) {
+        int begin, end;
+        block_range(AP.size(), tid, pool.size(), begin, end);
+        for (int i = begin; i < end; ++i) {
+            float* a_row = AP.row(i) - i;
+            for (int j = i; j < AP.size(); ++j) {
+                a_row[j] = 1.0f / (i + j + 2.0f);
+            }
+        }
+    });
+}
+
+// Sparse test matrix: the entries of A = 1/(i+j+2) at a fixed pseudo-random
+// pattern (same seed every run). Row lengths vary uniformly in
+// [1, 2 * nnz_per_row - 1] to mimic irregular real matrices; the diagonal is
+// always present.
+CsrMatrix make_sparse_test_matrix(int n, int nnz_per_row) {
+    CsrMatrix S;
+    S.rows = S.cols = n;
+    S.row_ptr.reserve(n + 1);
+    mt19937 rng(5522);
+    uniform_int_distribution<int> length_dist(1, max(1, 2 * nnz_per_row - 1));
+    uniform_int_distribution<int> col_dist(0, max(0, n - 1));
+    vector<int> cols;
+    for (int i = 0; i < n; ++i) {
+        const int length = min(n, length_dist(rng));
+        cols.assign(1, i);
+        while ((int)cols.size() < length) {
+            while ((int)cols.size() < length) cols.push_back(col_dist(rng));
+            sort(cols.begin(), cols.end());
+            cols.erase(unique(cols.begin(), cols.end()), cols.end());
+        }
+        for (int j : cols) {
+            S.col_idx.push_back(j);
+            S.values.push_back(1.0f / (i + j + 2.0f));
+        }
+        S.row_ptr.push_back((int)S.col_idx.size());
+    }
+    return S;
+}
+
+// Block-structured sparse test matrix (FEM-like): dense block x block blocks of
+// 1/(i+j+2) at a pseudo-random block pattern, about nnz_per_row / block
+// blocks per block row (varying), the diagonal block always present.
+CsrMatrix make_block_sparse_test_matrix(int n, int nnz_per_row, int block) {
+    CsrMatrix S;
+    S.rows = S.cols = n;
+    const int block_rows = (n + block - 1) / block;
+    const int blocks_per_row = max(1, nnz_per_row / block);
+    mt19937 rng(5522);
+    uniform_int_distribution<int> length_dist(1, 2 * blocks_per_row - 1);
+    uniform_int_distribution<int> col_dist(0, block_rows - 1);
+    vector<int> block_cols;
+    for (int I = 0; I < block_rows; ++I) {
+        const int length = min(block_rows, length_dist(rng));
+        block_cols.assign(1, I);
+        while ((int)block_cols.size() < length) {
+            while ((int)block_cols.size() < length) block_cols.push_back(col_dist(rng));
+            sort(block_cols.begin(), block_cols.end());
+            block_cols.erase(unique(block_cols.begin(), block_cols.end()), block_cols.end());
+        }
+        for (int i = I * block; i < min(n, (I + 1) * block); ++i) {
+            for (int J : block_cols) {
+                for (int j = J * block; j < min(n, (J + 1) * block); ++j) {
+                    S.col_idx.push_back(j);
+                    S.values.push_back(1.0f / (i + j + 2.0f));
+                }
+            }
+            S.row_ptr.push_back((int)S.col_idx.size());
+        }
+    }
+    return S;
+}
+
+// Banded test matrix: A[i][j] = 1/(i+j+2) for -kl <= j - i <= ku, zero elsewhere
+void init_band_matrix(BandMatrix& M) {
+    const int n = M.size();
+    for (int d = -M.kl(); d <= M.ku(); ++d) {
+        float* diag = M.diag(d);
+        for (int i = max(0, -d); i < min(n, n - d); ++i) {
+            diag[i] = 1.0f / (i + (i + d) + 2.0f);
+        }
+    }
+}
+
+// --- NUMA Placement ---
+// Bandwidth each NUMA node sustained while streaming its threads' rows of A:
+// the node's bytes of A divided by its slowest thread's kernel time.
+void print_numa_report(const ThreadPool& pool, const AlignedMatrix& A, const vector<double>& thread_us) {
+    int max_node = 0;
+    for (int tid = 0; tid < pool.size(); ++tid) max_node = max(max_node, pool.node(tid));
+    for (int node = 0; node <= max_node; ++node) {
+        int threads = 0, rows = 0;
+        double slowest_us = 0.0;
+        for (int tid = 0; tid < pool.size(); ++tid) {
+            if (pool.node(tid) != node) continue;
+            int begin, end;
+            block_range(A.rows(), tid, pool.size(), begin, end);
+            ++threads;
+            rows += end - begin;
+            slowest_us = max(slowest_us, thread_us[tid]);
+        }
+        if (threads == 0) continue;
+        double bytes = (double)rows * A.ld() * sizeof(float);
+        cout << "NUMA node " << node << ": Threads = " << threads << "\tRows = " << rows
+             << "\tBandwidth = " << (slowest_us > 0 ? bytes / slowest_us * 1e-3 : 0.0) << " GB/s" << endl;
+    }
+}
+
+// --- Hankel FFT GEMV ---
+// The test matrix depends only on i+j, i.e. it is a Hankel matrix defined by
+// the 2n-1 values h[m] = A[i][j] for i+j = m. Then
+//   C[i] = sum_j h[i+j] B[j] = (h * rev(B))[i + n - 1],
+// a linear convolution, which costs O(n log n) with FFTs instead of O(n^2) and
+// needs O(n) memory. Any circular convolution of length L >= 2n-1 leaves
+// entries n-1 .. 2n-2 unaliased.
+
+// In-place iterative radix-2 complex FFT of a fixed power-of-two size. Twiddles
+// and the bit-reversal permutation are computed once, outside the timed region.
+class FFTPlan {
+public:
+    explicit FFTPlan(size_t size) : len(size), twiddles(size / 2), bitrev(size) {
+        for (size_t k = 0; k < len / 2; ++k) {
+            twiddles[k] = polar(1.0, -2.0 * M_PI * k / len);
+        }
+        int bits = 0;
+        while (((size_t)1 << bits) < len) ++bits;
+        for (size_t i = 0; i < len; ++i) {
+            size_t r = 0;
+            for (int b = 0; b < bits; ++b) r |= ((i >> b) & 1) << (bits - 1 - b);
+            bitrev[i] = r;
+        }
+    }
+
+    size_t size() const { return len; }
+
+    void forward(complex<double>* data) const {
+        for (size_t i = 0; i < len; ++i) {
+            if (i < bitrev[i]) swap(data[i], data[bitrev[i]]);
+        }
+        for (size_t half = 1; half < len; half *= 2) {
+            const size_t step = len / (2 * half);
+            for (size_t start = 0; start < len; start += 2 * half) {
+                for (size_t j = 0; j < half; ++j) {
+                    complex<double> u = data[start + j];
+                    complex<double> v = data[start + j + half] * twiddles[j * step];
+                    data[start + j] = u + v;
+                    data[start + j + half] = u - v;
+                }
+            }
+        }
+    }
+
+    // Inverse transform including the 1/size scaling
+    void inverse(complex<double>* data) const {
+        for (size_t i = 0; i < len; ++i) data[i] = conj(data[i]);
+        forward(data);
+        const double scale = 1.0 / len;
+        for (size_t i = 0; i < len; ++i) data[i] = conj(data[i]) * scale;
+    }
+
+private:
+    size_t len;
+    vector<complex<double>> twiddles;
+    vector<size_t> bitrev;
+};
+
+// Smallest power-of-two FFT length that holds the Hankel product for size n
+size_t hankel_fft_size(int n) {
+    size_t len = 1;
+    while (len < (size_t)(2 * n - 1)) len *= 2;
+    return len;
+}
+
+// C = H * B for the n x n Hankel matrix defined by h[0 .. 2n-2]. Both real
+// sequences are transformed with one complex FFT (h in the real part, rev(B) in
+// the imaginary part) and separated using the conjugate symmetry of real
+// spectra. Computed in double precision; work must hold plan.size() values.
+void Mv_mult_hankel(const float* h, int n, const float* B, float* C,
+                    const FFTPlan& plan, complex<double>* work) {
+    const size_t len = plan.size();
+    for (size_t m = 0; m < len; ++m) {
+        double re = m < (size_t)(2 * n - 1) ? h[m] : 0.0;
+        double im = m < (size_t)n ? B[n - 1 - m] : 0.0;
+        work[m] = complex<double>(re, im);
+    }
+    plan.forward(work);
+    // Z = H + iX with H, X real-signal spectra:
+    //   H[k] = (Z[k] + conj(Z[-k])) / 2,  X[k] = (Z[k] - conj(Z[-k])) / 2i
+    // Both halves k and len-k are updated together from the original values.
+    for (size_t k = 0; k <= len / 2; ++k) {
+        size_t nk = (len - k) & (len - 1);
+        complex<double> zk = work[k], znk = work[nk];
+        complex<double> hk = (zk + conj(znk)) * 0.5, xk = (zk - conj(znk)) * complex<double>(0.0, -0.5);
+        complex<double> hnk = (znk + conj(zk)) * 0.5, xnk = (znk - conj(zk)) * complex<double>(0.0, -0.5);
+        work[k] = hk * xk;
+        work[nk] = hnk * xnk;
+    }
+    plan.inverse(work);
+    for (int i = 0; i < n; ++i) {
+        C[i] = (float)work[i + n - 1].real();
+    }
+}
+
+// Floating-point work of one Mv_mult_hankel call: two complex FFTs of length L
+// (the packed forward transform and the inverse) at the usual 5 L log2 L
+// each, plus about 8 flops per bin for separating the spectra and multiplying
+// them (two complex products per bin pair) and 2 for the inverse scaling.
+double hankel_flops(size_t len) {
+    return 2.0 * 5.0 * len * log2((double)len) + 10.0 * len;
+}
+
+// Largest n for which the hankel type also builds A to check itself against the
+// dense AVX2 kernel (A takes n^2 floats, 256 MB at this size).
+const int HANKEL_CHECK_MAX_N = 8192;
+
+// Largest |C[i] - ref[i]| / |ref[i]| over all i
+template <typename T, typename R>
+double max_relative_error(const T* C, const R* ref, int n) {
+    double worst = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double denom = fabs((double)ref[i]);
+        double err = (double)fabs((long double)C[i] - (long double)ref[i]);
+        worst = max(worst, denom > 0 ? err / denom : err);
+    }
+    return worst;
+}
+
+// Largest n for which the reduced-precision types also time the fp32 kernel
+// on a dense copy of A (1 GB)
+const int REDUCED_PRECISION_TIMING_MAX_N = 16384;
+
+// fp32 reference C = A * B for the reduced-precision kernels. A is rebuilt a
+// few rows at a time exactly as init_matrix does and multiplied by
+// Mv_mult_avx2, so checking large n needs no dense fp32 copy of A. Uses AVX2
+// unconditionally: every opt type that reports against it requires AVX2.
+void reference_mv_avx2(int n, const float* B, float* C) {
+    const int block_rows = 64;
+    AlignedMatrix tile(block_rows, n);
+    for (int i0 = 0; i0 < n; i0 += block_rows) {
+        const int rows = min(block_rows, n - i0);
+        for (int r = 0; r < rows; ++r) fill_test_row_avx2(tile.row(r), i0 + r, n, tile.ld());
+        Mv_mult_avx2(tile.data(), rows, n, tile.ld(), B, C + i0);
+    }
+}
+
+// Exact-as-possible C = A * B for the precision types: long double sums over
+// the mathematical test matrix rather than over a rounded copy. A[i][j] =
+// 1/(i+j+2) depends only on i + j, so its 2n - 1 distinct values are computed once.
+vector<long double> reference_mv_exact(int n) {
+    vector<long double> h(max(0, 2 * n - 1)), x(n), y(n);
+    for (size_t k = 0; k < h.size(); ++k) h[k] = 1.0L / (k + 2);
+    for (int j = 0; j < n; ++j) x[j] = 1.0L / (j + 2);
+    for (int i = 0; i < n; ++i) {
+        long double sum = 0.0L;
+        for (int j = 0; j < n; ++j) sum += h[i + j] * x[j];
+        y[i] = sum;
+    }
+    return y;
+}
+
 // --- Main Function ---
 int main(int argc, char **argv)
 {
     string opt_type;
     int n;
+    int num_threads = max(1u, thread::hardware_concurrency());
+    string isa = select_isa();
+    int tile = 4096;
+    PageBacking pages = PageBacking::Default;
+    bool numa = false;
+    int batch = 8;
+    int nnz_per_row = 32;
+    int sigma = 256;
+    int block = 4;
+    int bandwidth = 8;
+
+    // Split "--name=value" options from the positional arguments
+    vector<string> args;
+    for (int a = 1; a < argc; ++a) {
+        string name, value;
+        if (!parse_option(argv[a], name, value)) {
+            args.push_back(argv[a]);
+        } else if (name == "threads" && atoi(value.c_str()) > 0) {
+            num_threads = atoi(value.c_str());
+        } else if (name == "tile" && atoi(value.c_str()) > 0) {
+            tile = atoi(value.c_str());
+        } else if (name == "batch" && atoi(value.c_str()) > 0) {
+            batch = atoi(value.c_str());
+        } else if (name == "nnz" && atoi(value.c_str()) > 0) {
+            nnz_per_row = atoi(value.c_str());
+        } else if (name == "sigma" && atoi(value.c_str()) > 0) {
+            sigma = atoi(value.c_str());
+        } else if (name == "block" && (value == "4" || value == "8")) {
+            block = atoi(value.c_str());
+        } else if (name == "bandwidth" && !value.empty() && atoi(value.c_str()) >= 0) {
+            bandwidth = atoi(value.c_str());
+        } else if (name == "pages" && (value == "default" || value == "thp" || value == "hugetlb")) {
+            pages = value == "thp" ? PageBacking::TransparentHuge
+                  : value == "hugetlb" ? PageBacking::HugeTLB : PageBacking::Default;
+        } else if (name == "numa" && value.empty()) {
+            numa = true;
+        } else if (name == "isa" && (value == "scalar" || value == "sse4.2" ||
+                                     value == "avx2" || value == "avx512")) {
+            isa = value;
+        } else {
+            cerr << "Error: Invalid option '" << argv[a] << "'" << endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
 
-    if (argc == 2) {
-        // Default to avx2 if only matrix size is provided
-        opt_type = "avx2";
-        n = atoi(argv[1]);
-    } else if (argc == 3) {
+    if (args.size() == 1) {
+        // Default to the runtime-dispatched kernel if only matrix size is provided
+        opt_type = "auto";
+        n = atoi(args[0].c_str());
+    } else if (args.size() == 2) {
         // User specifies optimization type and matrix size
-        opt_type = argv[1];
-        n = atoi(argv[2]);
+        opt_type = args[0];
+        n = atoi(args[1].c_str());
     } else {
         // Incorrect number of arguments
         print_usage(argv[0]);
         return 1;
     }
+
+    // Kernels hardwired to one instruction set need it on this CPU
+    if (requires_avx2(opt_type)) isa = "avx2";
+    if (opt_type == "fp16") isa = "f16c";
+    if (opt_type == "bf16") isa = isa == "avx512" && cpu_supports_isa("avx512bf16") ? "avx512bf16" : "avx2";
+    if (opt_type == "int8") isa = isa == "avx512" && cpu_supports_isa("avx512vnni") ? "avx512vnni" : "avx2";
+    if (opt_type == "avx512") {
+        if (cpu_supports_isa("avx512")) {
+            isa = "avx512";
+        } else {
+            cerr << "Warning: AVX-512 not supported on this CPU, using '" << isa << "' instead" << endl;
+            opt_type = "auto";
+        }
+    }
+    if (!cpu_supports_isa(isa)) {
+        cerr << "Error: This CPU does not support the '" << isa << "' instruction set" << endl;
+        return 1;
+    }
+    if (numa && opt_type != "parallel") {
+        cerr << "Error: --numa requires the 'parallel' optimization type" << endl;
+        return 1;
+    }
+
+    // Spawn workers before timing so only the multiply itself is measured.
+    // The pool also initializes A for every optimization type.
+    ThreadPool pool(num_threads, numa);
     
-    vector<float> A(n * n), B(n), C(n);
+    // Matrix-free kernels generate A themselves and structured-storage kernels
+    // keep their own copy, so neither allocates the dense A.
+    // A is left untouched here: init_matrix writes every element, padding included.
+    const bool matrix_free = !uses_dense_matrix(opt_type);
+    PackedSymmetricMatrix AP(opt_type == "symv" ? n : 0);
+    CsrMatrix S;
+    SellMatrix SELL;
+    BsrMatrix BSR;
+    const int band_w = min(bandwidth, max(0, n - 1));
+    BandMatrix BAND(opt_type == "band" ? n : 0, band_w, band_w);
+    AlignedMatrixOf<uint16_t> A16(opt_type == "fp16" || opt_type == "bf16" ? n : 0, n, PageBacking::Default, false);
+    Bf16Matrix B16(opt_type == "bf16" ? 1 : 0, n);
+    AlignedMatrixOf<int8_t> A8(opt_type == "int8" ? n : 0, n, PageBacking::Default, false);
+    AlignedMatrixOf<int8_t> B8(opt_type == "int8" ? 1 : 0, n);
+    vector<float> a8_scale(opt_type == "int8" ? n : 0);
+    vector<float> b8_lane_scale(opt_type == "int8" ? round_up(n, 64) / 4 : 0);
+    const bool fp64_result = opt_type == "mixed" || opt_type == "fp64";
+    AlignedMatrixOf<double> A64(opt_type == "fp64" ? n : 0, n, PageBacking::Default, false);
+    AlignedMatrixOf<double> B64(opt_type == "fp64" ? 1 : 0, n), C64(fp64_result ? 1 : 0, n);
+    AlignedMatrix A(matrix_free ? 0 : n, n, pages, false), B(1, n), C(1, n);
 
     // Initialize matrices (using Mv.cpp logic for consistency)
+    double init_start = microtime();
     for (int i = 0; i < n; ++i) {
-        B[i] = 1.0f / (i + 2.0f); // j is always 0 for a vector
-        for (int j = 0; j < n; ++j) {
-            A[i * n + j] = 1.0f / (i + j + 2.0f);
-        }
+        B.data()[i] = 1.0f / (i + 2.0f); // j is always 0 for a vector
+    }
+    if (!matrix_free) {
+        init_matrix(A, pool);
+    } else if (opt_type == "symv") {
+        init_packed_matrix(AP, pool);
+    } else if (opt_type == "csr") {
+        S = make_sparse_test_matrix(n, nnz_per_row);
+    } else if (opt_type == "sell") {
+        SELL = csr_to_sell(make_sparse_test_matrix(n, nnz_per_row), sell_chunk_size_for_isa(isa), sigma);
+    } else if (opt_type == "bsr") {
+        S = make_block_sparse_test_matrix(n, nnz_per_row, block);
+        BSR = csr_to_bsr(S, block);
+    } else if (opt_type == "bcsr") {
+        S = make_block_sparse_test_matrix(n, nnz_per_row, block);
+    } else if (opt_type == "band") {
+        init_band_matrix(BAND);
+    } else if (opt_type == "fp16") {
+        init_half_matrix(A16, pool);
+    } else if (opt_type == "bf16") {
+        init_bf16_matrix(A16, pool);
+        for (int i = 0; i < n; ++i) B16.data()[i] = float_to_bf16(B.data()[i]);
+    } else if (opt_type == "int8") {
+        init_int8_matrix(A8, a8_scale.data(), pool);
+        quantize_int8_groups(B.data(), n, B8.data(), b8_lane_scale.data());
+    } else if (opt_type == "fp64") {
+        init_double_matrix(A64, pool);
+        for (int i = 0; i < n; ++i) B64.data()[i] = 1.0 / (i + 2.0);
+    }
+    double init_us = microtime() - init_start;
+    const float* a = A.data();
+    const size_t ld = A.ld();
+    const float* b = B.data();
+    float* c = C.data();
+
+    vector<double> thread_us(pool.size());
+    AlignedMatrix partials(opt_type == "transpose_parallel" ? pool.size() : 0, n);
+    AlignedMatrix Z(1, opt_type == "fused" ? n : 0); // A^T * B output of 'fused'
+
+    // Batched setup: right-hand side v is B_v[j] = 1/(j+v+2), so vector 0 is B
+    // and column 0 of the result is directly comparable with the other types
+    const int nvec = (opt_type == "batched") ? batch : 1;
+    AlignedMatrix B_batch(opt_type == "batched" ? n : 0, nvec);
+    AlignedMatrix C_batch(B_batch.rows(), nvec);
+    for (int j = 0; j < B_batch.rows(); ++j) {
+        for (int v = 0; v < nvec; ++v) B_batch.row(j)[v] = 1.0f / (j + v + 2.0f);
+    }
+
+    // Hankel setup: the 2n-1 defining values, FFT plan and workspace
+    vector<float> h;
+    unique_ptr<FFTPlan> plan;
+    vector<complex<double>> fft_work;
+    if (opt_type == "hankel") {
+        h.resize(2 * n - 1);
+        for (int m = 0; m < 2 * n - 1; ++m) h[m] = 1.0f / (m + 2.0f);
+        plan.reset(new FFTPlan(hankel_fft_size(n)));
+        fft_work.resize(plan->size());
     }
 
     double time1 = microtime();
     
-    if (opt_type == "avx2") {
-        Mv_mult_avx2(n, A, B, C);
+    if (opt_type == "auto") {
+        kernel_for_isa(isa)(a, n, n, ld, b, c);
+    } else if (opt_type == "avx2") {
+        Mv_mult_avx2(a, n, n, ld, b, c);
+    } else if (opt_type == "avx2x2") {
+        Mv_mult_avx2_multiacc<2>(a, n, n, ld, b, c);
+    } else if (opt_type == "avx2x4") {
+        Mv_mult_avx2_multiacc<4>(a, n, n, ld, b, c);
+    } else if (opt_type == "avx2x8") {
+        Mv_mult_avx2_multiacc<8>(a, n, n, ld, b, c);
+    } else if (opt_type == "avx2r4") {
+        Mv_mult_avx2_rowblock<4>(a, n, n, ld, b, c);
+    } else if (opt_type == "avx2r8") {
+        Mv_mult_avx2_rowblock<8>(a, n, n, ld, b, c);
+    } else if (opt_type == "blocked") {
+        Mv_mult_blocked(a, n, n, ld, b, c, tile);
+    } else if (opt_type == "hilbert") {
+        Mv_mult_hilbert(0, n, n, b, c);
+    } else if (opt_type == "batched") {
+        Mv_mult_batched(a, n, n, ld, B_batch.data(), nvec, B_batch.ld(), C_batch.data(), C_batch.ld());
+    } else if (opt_type == "hankel") {
+        Mv_mult_hankel(h.data(), n, b, c, *plan, fft_work.data());
+    } else if (opt_type == "avx512") {
+        Mv_mult_avx512(a, n, n, ld, b, c);
     } else if (opt_type == "unroll") {
-        Mv_mult_unrolled(n, A, B, C);
+        Mv_mult_unrolled(a, n, n, ld, b, c);
     } else if (opt_type == "interchange") {
-        Mv_mult_interchanged(n, A, B, C);
+        Mv_mult_interchanged(a, n, n, ld, b, c);
+    } else if (opt_type == "transpose") {
+        Mv_mult_transposed(a, n, n, ld, b, c);
+    } else if (opt_type == "transpose_parallel") {
+        Mv_mult_transposed_parallel(a, n, n, ld, b, c, pool, partials);
+    } else if (opt_type == "fused") {
+        Mv_mult_fused(a, n, n, ld, b, b, c, Z.data());
+    } else if (opt_type == "symv") {
+        Mv_mult_symv_packed(AP, b, c);
+    } else if (opt_type == "csr" || opt_type == "bcsr") {
+        Mv_mult_csr(S, b, c, pool, isa == "avx2" || isa == "avx512");
+    } else if (opt_type == "band") {
+        Mv_mult_band(BAND, b, c);
+    } else if (opt_type == "fp16") {
+        Mv_mult_fp16(A16.data(), n, n, A16.ld(), b, c);
+    } else if (opt_type == "bf16") {
+        if (isa == "avx512bf16") {
+            Mv_mult_bf16_avx512(A16.data(), n, n, A16.ld(), B16.data(), c);
+        } else {
+            Mv_mult_bf16_avx2(A16.data(), n, n, A16.ld(), B16.data(), c);
+        }
+    } else if (opt_type == "kahan") {
+        Mv_mult_kahan(a, n, n, ld, b, c);
+    } else if (opt_type == "pairwise") {
+        Mv_mult_pairwise(a, n, n, ld, b, c);
+    } else if (opt_type == "fp32") {
+        Mv_mult_avx2_typed<float, float>(a, n, n, ld, b, c);
+    } else if (opt_type == "mixed") {
+        Mv_mult_avx2_typed<float, double>(a, n, n, ld, b, C64.data());
+    } else if (opt_type == "fp64") {
+        Mv_mult_avx2_typed<double, double>(A64.data(), n, n, A64.ld(), B64.data(), C64.data());
+    } else if (opt_type == "int8") {
+        if (isa == "avx512vnni") {
+            Mv_mult_int8_vnni(A8.data(), a8_scale.data(), n, n, A8.ld(), B8.data(), b8_lane_scale.data(), c);
+        } else {
+            Mv_mult_int8_avx2(A8.data(), a8_scale.data(), n, n, A8.ld(), B8.data(), b8_lane_scale.data(), c);
+        }
+    } else if (opt_type == "bsr") {
+        Mv_mult_bsr(BSR, b, c, pool, isa == "avx2" || isa == "avx512");
+    } else if (opt_type == "sell") {
+        Mv_mult_sell(SELL, b, c, pool, isa);
+    } else if (opt_type == "parallel") {
+        Mv_mult_parallel(a, n, n, ld, b, c, pool, kernel_for_isa(isa), thread_us.data());
     } else {
         cerr << "Error: Unknown optimization type '" << opt_type << "'" << endl;
         print_usage(argv[0]);
@@ -129,11 +2168,124 @@ int main(int argc, char **argv)
     
     double time2 = microtime();
     double t = time2 - time1;
+    double flops = 2.0 * n * n * nvec * (opt_type == "fused" ? 2 : 1);
+    if (opt_type == "csr" || opt_type == "bsr" || opt_type == "bcsr") {
+        flops = 2.0 * S.nnz(); // sparse: only nonzeros count
+    }
+    if (opt_type == "sell") flops = 2.0 * SELL.nnz;
+    if (opt_type == "hankel") flops = hankel_flops(plan->size()); // FFT work, not 2n^2
+    if (opt_type == "band") {
+        // Entries inside the band: n on the diagonal, n - d on diagonals +-d
+        flops = 2.0 * ((double)n * (2 * band_w + 1) - (double)band_w * (band_w + 1));
+    }
+    for (int i = 0; i < C_batch.rows(); ++i) c[i] = C_batch.row(i)[0];
+    if (fp64_result) {
+        for (int i = 0; i < n; ++i) c[i] = static_cast<float>(C64.data()[i]);
+    }
 
     // Output in the exact same format as Mv.cpp
     cout << "\nTime = " << t << " us\tTimer Resolution = " << get_microtime_resolution() 
-         << " us\tPerformance = " << 2.0 * n * n * 1e-3 / t << " Gflop/s" << endl;
-    cout << "C[N/2] = " << static_cast<double>(C[n/2]) << "\n" << endl;
+         << " us\tPerformance = " << flops * 1e-3 / t << " Gflop/s" << endl;
+    cout << "C[N/2] = " << static_cast<double>(c[n/2]) << "\n" << endl;
+    if (opt_type == "auto" || opt_type == "avx512" || opt_type == "parallel" || opt_type == "csr" ||
+        opt_type == "sell" || opt_type == "bsr" || opt_type == "bcsr" || opt_type == "bf16" ||
+        opt_type == "int8") {
+        cout << "ISA = " << isa << endl;
+    }
+    if (pages != PageBacking::Default) {
+        cout << "Page backing = " << page_backing_name(A.backing()) << " (requested "
+             << page_backing_name(pages) << ")\tHuge pages = " << (A.huge_page_bytes() >> 20)
+             << " MB of " << (A.bytes() >> 20) << " MB" << endl;
+    }
+    if (opt_type == "fused") {
+        cout << "(A^T*B)[N/2] = " << static_cast<double>(Z.data()[n/2])
+             << "\tTime per product = " << t / 2 << " us" << endl;
+    }
+    if (opt_type == "symv") {
+        cout << "Packed storage = " << (AP.bytes() >> 10) << " KB\tDense storage = "
+             << (((size_t)n * round_up(n, SIMD_PAD) * sizeof(float)) >> 10) << " KB" << endl;
+    }
+    if (opt_type == "batched") {
+        cout << "Vectors = " << nvec << "\tTime per vector = " << t / nvec << " us" << endl;
+    }
+    cout << "Init time = " << init_us << " us\tInit threads = " << pool.size() << endl;
+    if (opt_type == "band") {
+        cout << "Bandwidth = " << band_w << "\tBand storage = " << (BAND.bytes() >> 10) << " KB" << endl;
+    }
+    if (opt_type == "bsr") {
+        cout << "Blocks = " << BSR.num_blocks() << " (" << block << "x" << block << ")\tIndex bytes = "
+             << (BSR.block_col.size() + BSR.block_row_ptr.size()) * sizeof(int) << " (CSR: "
+             << (S.col_idx.size() + S.row_ptr.size()) * sizeof(int) << ")" << endl;
+    }
+    if (opt_type == "csr" || opt_type == "bsr" || opt_type == "bcsr") {
+        cout << "nnz = " << S.nnz() << "\tAverage per row = " << (double)S.nnz() / n << endl;
+    }
+    if (opt_type == "sell") {
+        cout << "nnz = " << SELL.nnz << "\tC = " << SELL.chunk_size << "\tsigma = " << SELL.sigma
+             << "\tFill efficiency = " << (double)SELL.nnz / max<size_t>(1, SELL.values.size()) << endl;
+    }
+    if (opt_type == "parallel" || opt_type == "transpose_parallel" || opt_type == "csr" ||
+        opt_type == "sell" || opt_type == "bsr" || opt_type == "bcsr") {
+        cout << "Threads = " << pool.size() << "\tPerformance per thread = "
+             << flops * 1e-3 / t / pool.size() << " Gflop/s" << endl;
+        if (pool.is_pinned()) print_numa_report(pool, A, thread_us);
+    }
+    if (opt_type == "fp16" || opt_type == "bf16" || opt_type == "int8") {
+        // Accuracy vs speed against fp32: time Mv_mult_avx2 on a dense fp32
+        // copy when one fits, otherwise only stream the fp32 reference
+        const size_t a_bytes = opt_type == "int8" ? A8.bytes() + a8_scale.size() * sizeof(float) : A16.bytes();
+        cout << "A storage = " << (a_bytes >> 10) << " KB (fp32: "
+             << (((size_t)n * round_up(n, SIMD_PAD) * sizeof(float)) >> 10) << " KB)" << endl;
+        AlignedMatrix C_ref(1, n);
+        if (n <= REDUCED_PRECISION_TIMING_MAX_N) {
+            AlignedMatrix A_ref(n, n);
+            init_matrix(A_ref, pool);
+            double ref_start = microtime();
+            Mv_mult_avx2(A_ref.data(), n, n, A_ref.ld(), b, C_ref.data());
+            double ref_us = microtime() - ref_start;
+            cout << "fp32 avx2 time = " << ref_us << " us\tSpeedup = " << ref_us / t << "x" << endl;
+        } else {
+            reference_mv_avx2(n, b, C_ref.data());
+        }
+        cout << "Max relative error vs fp32 avx2 = " << max_relative_error(c, C_ref.data(), n) << endl;
+        if (opt_type == "int8") {
+            // Share of the error from quantizing B (groups of INT8_GROUP), the rest is A's
+            vector<float> B_dequant(n);
+            for (int j = 0; j < n; ++j) B_dequant[j] = b8_lane_scale[j / 4] * B8.data()[j];
+            cout << "Max relative error of int8 B = " << max_relative_error(B_dequant.data(), b, n) << endl;
+        }
+    }
+    if (opt_type == "fp32" || fp64_result) {
+        vector<long double> C_exact = reference_mv_exact(n);
+        cout << "Storage = " << (opt_type == "fp64" ? "fp64" : "fp32") << "\tAccumulation = "
+             << (fp64_result ? "fp64" : "fp32") << endl;
+        cout << "Max relative error vs exact = "
+             << (fp64_result ? max_relative_error(C64.data(), C_exact.data(), n)
+                             : max_relative_error(c, C_exact.data(), n)) << endl;
+    }
+    if (opt_type == "kahan" || opt_type == "pairwise") {
+        // Cost and benefit against the plain single-accumulator FMA kernel on the same A
+        AlignedMatrix C_plain(1, n);
+        double plain_start = microtime();
+        Mv_mult_avx2(a, n, n, ld, b, C_plain.data());
+        double plain_us = microtime() - plain_start;
+        vector<long double> C_exact = reference_mv_exact(n);
+        cout << "Plain FMA time = " << plain_us << " us\tSlowdown = " << t / plain_us << "x" << endl;
+        cout << "Max relative error vs exact = " << max_relative_error(c, C_exact.data(), n)
+             << " (plain FMA: " << max_relative_error(C_plain.data(), C_exact.data(), n) << ")" << endl;
+    }
+    if (opt_type == "hankel") {
+        cout << "FFT length = " << plan->size() << "\tDense-equivalent performance = "
+             << 2.0 * n * n * 1e-3 / t << " Gflop/s (2n^2 flops, not work done)" << endl;
+        if (n <= HANKEL_CHECK_MAX_N && cpu_supports_isa("avx2")) {
+            AlignedMatrix A_ref(n, n), C_ref(1, n);
+            init_matrix(A_ref, pool);
+            Mv_mult_avx2(A_ref.data(), n, n, A_ref.ld(), b, C_ref.data());
+            cout << "Max relative error vs avx2 = " << max_relative_error(c, C_ref.data(), n) << endl;
+        } else {
+            cout << "Accuracy check vs avx2 skipped (needs AVX2 and n <= " << HANKEL_CHECK_MAX_N << ")" << endl;
+        }
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -19,6 +19,25 @@ BENCHMARKS=(
     "hw1_interchange:./hw1 interchange"
     "hw1_unroll:./hw1 unroll"
     "hw1_avx2:./hw1 avx2"
+    "hw1_avx2x4:./hw1 avx2x4"
+    "hw1_avx2r4:./hw1 avx2r4"
+    "hw1_blocked:./hw1 blocked"
+    "hw1_hilbert:./hw1 hilbert"
+    "hw1_hankel:./hw1 hankel"
+    "hw1_batched:./hw1 batched"
+    "hw1_transpose:./hw1 transpose"
+    "hw1_fused:./hw1 fused"
+    "hw1_symv:./hw1 symv"
+    "hw1_fp16:./hw1 fp16"
+    "hw1_bf16:./hw1 bf16"
+    "hw1_int8:./hw1 int8"
+    "hw1_mixed:./hw1 mixed"
+    "hw1_fp64:./hw1 fp64"
+    "hw1_kahan:./hw1 kahan"
+    "hw1_pairwise:./hw1 pairwise"
+    "hw1_avx512:./hw1 avx512"
+    "hw1_auto:./hw1 auto"
+    "hw1_parallel:./hw1 parallel"
 )
 RESULTS_FILE="results.json"
 